@@ -0,0 +1,231 @@
+#include <rlang.h>
+#include "vctrs.h"
+#include "altrep-view.h"
+#include "altrep.h"
+
+#if (!HAS_ALTREP)
+
+#include <R_ext/Rdynload.h>
+
+void vctrs_init_altrep_view(DllInfo* dll) { }
+
+bool altrep_view_supports(SEXP x) {
+  return false;
+}
+
+SEXP altrep_view_make(SEXP x, R_len_t start, R_len_t size) {
+  Rf_error("Need R 3.5+ for Altrep support.");
+  return R_NilValue;
+}
+
+#else
+
+
+// Initialised at load time
+R_altrep_class_t altrep_view_integer_class;
+R_altrep_class_t altrep_view_real_class;
+
+
+/*
+ * A view is a read-only window of `size` elements of a parent vector,
+ * starting at the 0-based location `start`.
+ *
+ * - Until the view is materialized, `data1` is the parent and `data2` is
+ *   an integer vector of `c(start, size)`.
+ * - Once materialized, `data1` is a regular vector holding the elements of
+ *   the view and `data2` is `NULL`. This releases the parent.
+ *
+ * Reads, including `DATAPTR_RO()`, point directly into the parent. Only
+ * writable access to the data pointer materializes the view.
+ */
+
+bool altrep_view_supports(SEXP x) {
+  switch (TYPEOF(x)) {
+  case INTSXP:
+  case REALSXP:
+    return !ALTREP(x) && ATTRIB(x) == R_NilValue;
+  default:
+    return false;
+  }
+}
+
+SEXP altrep_view_make(SEXP x, R_len_t start, R_len_t size) {
+  R_altrep_class_t cls;
+
+  switch (TYPEOF(x)) {
+  case INTSXP: cls = altrep_view_integer_class; break;
+  case REALSXP: cls = altrep_view_real_class; break;
+  default: stop_unimplemented_type("altrep_view_make", TYPEOF(x));
+  }
+
+  SEXP window = PROTECT(Rf_allocVector(INTSXP, 2));
+  int* p_window = INTEGER(window);
+  p_window[0] = start;
+  p_window[1] = size;
+
+  // The parent is now shared with the view
+  MARK_NOT_MUTABLE(x);
+
+  SEXP out = R_new_altrep(cls, x, window);
+
+  UNPROTECT(1);
+  return out;
+}
+
+static inline bool altrep_view_is_materialized(SEXP x) {
+  return R_altrep_data2(x) == R_NilValue;
+}
+
+static inline R_xlen_t altrep_view_start(SEXP x) {
+  SEXP window = R_altrep_data2(x);
+  return window == R_NilValue ? 0 : INTEGER(window)[0];
+}
+
+static const void* altrep_view_ptr(SEXP x) {
+  // `data1` is never ALTREP, so this doesn't allocate
+  SEXP data = R_altrep_data1(x);
+  R_xlen_t start = altrep_view_start(x);
+
+  switch (TYPEOF(data)) {
+  case INTSXP: return INTEGER(data) + start;
+  case REALSXP: return REAL(data) + start;
+  default: stop_unimplemented_type("altrep_view_ptr", TYPEOF(data));
+  }
+}
+
+static SEXP altrep_view_copy(SEXP x) {
+  SEXP data = R_altrep_data1(x);
+  R_xlen_t size = altrep_view_Length(x);
+
+  SEXP out = PROTECT(Rf_allocVector(TYPEOF(data), size));
+
+  switch (TYPEOF(data)) {
+  case INTSXP: memcpy(INTEGER(out), altrep_view_ptr(x), size * sizeof(int)); break;
+  case REALSXP: memcpy(REAL(out), altrep_view_ptr(x), size * sizeof(double)); break;
+  default: stop_unimplemented_type("altrep_view_copy", TYPEOF(data));
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+static SEXP altrep_view_materialize(SEXP x) {
+  if (altrep_view_is_materialized(x)) {
+    return R_altrep_data1(x);
+  }
+
+  SEXP out = PROTECT(altrep_view_copy(x));
+
+  R_set_altrep_data1(x, out);
+  R_set_altrep_data2(x, R_NilValue);
+
+  UNPROTECT(1);
+  return out;
+}
+
+// ALTREP methods -------------------
+
+R_xlen_t altrep_view_Length(SEXP x) {
+  SEXP window = R_altrep_data2(x);
+
+  if (window == R_NilValue) {
+    return Rf_xlength(R_altrep_data1(x));
+  } else {
+    return INTEGER(window)[1];
+  }
+}
+
+Rboolean altrep_view_Inspect(SEXP x,
+                             int pre,
+                             int deep,
+                             int pvec,
+                             void (*inspect_subtree)(SEXP, int, int, int)) {
+  Rprintf("vctrs_altrep_view (len=%d, start=%d, materialized=%s)\n",
+          (int) altrep_view_Length(x),
+          (int) altrep_view_start(x),
+          altrep_view_is_materialized(x) ? "T" : "F");
+  return TRUE;
+}
+
+// Duplicates are regular vectors. Attributes are copied by R.
+SEXP altrep_view_Duplicate(SEXP x, Rboolean deep) {
+  return altrep_view_copy(x);
+}
+
+// ALTVEC methods -------------------
+
+void* altrep_view_Dataptr(SEXP x, Rboolean writeable) {
+  if (!writeable) {
+    return (void*) altrep_view_ptr(x);
+  }
+
+  SEXP data = altrep_view_materialize(x);
+
+  switch (TYPEOF(data)) {
+  case INTSXP: return INTEGER(data);
+  case REALSXP: return REAL(data);
+  default: stop_unimplemented_type("altrep_view_Dataptr", TYPEOF(data));
+  }
+}
+
+const void* altrep_view_Dataptr_or_null(SEXP x) {
+  return altrep_view_ptr(x);
+}
+
+// ALTINTEGER / ALTREAL methods -----
+
+int altrep_view_integer_Elt(SEXP x, R_xlen_t i) {
+  return ((const int*) altrep_view_ptr(x))[i];
+}
+
+double altrep_view_real_Elt(SEXP x, R_xlen_t i) {
+  return ((const double*) altrep_view_ptr(x))[i];
+}
+
+#define VIEW_GET_REGION(CTYPE)                                  \
+  R_xlen_t size = altrep_view_Length(x);                        \
+  R_xlen_t n_copy = (size - i) < n ? (size - i) : n;            \
+                                                                \
+  if (n_copy <= 0) {                                            \
+    return 0;                                                   \
+  }                                                             \
+                                                                \
+  const CTYPE* p_x = ((const CTYPE*) altrep_view_ptr(x)) + i;   \
+  memcpy(buf, p_x, n_copy * sizeof(CTYPE));                     \
+                                                                \
+  return n_copy
+
+R_xlen_t altrep_view_integer_Get_region(SEXP x, R_xlen_t i, R_xlen_t n, int* buf) {
+  VIEW_GET_REGION(int);
+}
+R_xlen_t altrep_view_real_Get_region(SEXP x, R_xlen_t i, R_xlen_t n, double* buf) {
+  VIEW_GET_REGION(double);
+}
+
+#undef VIEW_GET_REGION
+
+
+static void init_altrep_view_class(R_altrep_class_t cls) {
+  // altrep
+  R_set_altrep_Length_method(cls, altrep_view_Length);
+  R_set_altrep_Inspect_method(cls, altrep_view_Inspect);
+  R_set_altrep_Duplicate_method(cls, altrep_view_Duplicate);
+
+  // altvec
+  R_set_altvec_Dataptr_method(cls, altrep_view_Dataptr);
+  R_set_altvec_Dataptr_or_null_method(cls, altrep_view_Dataptr_or_null);
+}
+
+void vctrs_init_altrep_view(DllInfo* dll) {
+  altrep_view_integer_class = R_make_altinteger_class("altrep_view_integer", "vctrs", dll);
+  init_altrep_view_class(altrep_view_integer_class);
+  R_set_altinteger_Elt_method(altrep_view_integer_class, altrep_view_integer_Elt);
+  R_set_altinteger_Get_region_method(altrep_view_integer_class, altrep_view_integer_Get_region);
+
+  altrep_view_real_class = R_make_altreal_class("altrep_view_real", "vctrs", dll);
+  init_altrep_view_class(altrep_view_real_class);
+  R_set_altreal_Elt_method(altrep_view_real_class, altrep_view_real_Elt);
+  R_set_altreal_Get_region_method(altrep_view_real_class, altrep_view_real_Get_region);
+}
+
+#endif // R version >= 3.5.0
@@ -0,0 +1,34 @@
+#ifndef ALTREP_VIEW_H
+#define ALTREP_VIEW_H
+
+#include "altrep.h"
+
+// Views are only worth their ALTREP overhead for large slices
+#define ALTREP_VIEW_MIN_SIZE 1024
+
+bool altrep_view_supports(SEXP x);
+SEXP altrep_view_make(SEXP x, R_len_t start, R_len_t size);
+
+#if (HAS_ALTREP)
+
+R_xlen_t altrep_view_Length(SEXP x);
+Rboolean altrep_view_Inspect(
+    SEXP x,
+    int pre,
+    int deep,
+    int pvec,
+    void (*inspect_subtree)(SEXP, int, int, int));
+SEXP altrep_view_Duplicate(SEXP x, Rboolean deep);
+void* altrep_view_Dataptr(SEXP x, Rboolean writeable);
+const void* altrep_view_Dataptr_or_null(SEXP x);
+int altrep_view_integer_Elt(SEXP x, R_xlen_t i);
+double altrep_view_real_Elt(SEXP x, R_xlen_t i);
+R_xlen_t altrep_view_integer_Get_region(SEXP x, R_xlen_t i, R_xlen_t n, int* buf);
+R_xlen_t altrep_view_real_Get_region(SEXP x, R_xlen_t i, R_xlen_t n, double* buf);
+
+extern R_altrep_class_t altrep_view_integer_class;
+extern R_altrep_class_t altrep_view_real_class;
+
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #include <rlang.h>
 #include "vctrs.h"
 #include "c.h"
+#include "cast.h"
 #include "dim.h"
 #include "ptype-common.h"
 #include "slice-assign.h"
@@ -15,6 +16,8 @@ static SEXP as_df_row_impl(SEXP x, struct name_repair_opts* name_repair);
 struct name_repair_opts validate_bind_name_repair(SEXP name_repair, bool allow_minimal);
 static SEXP vec_cbind(SEXP xs, SEXP ptype, SEXP size, struct name_repair_opts* name_repair);
 static SEXP cbind_names_to(bool has_names, SEXP names_to, SEXP ptype);
+static SEXP rbind_col_map(SEXP xs, SEXP ptype);
+static void rbind_assign_cols(SEXP out, SEXP xs, SEXP map, const int* ns);
 
 // [[ register(external = TRUE) ]]
 SEXP vctrs_rbind(SEXP call, SEXP op, SEXP args, SEXP env) {
@@ -98,9 +101,16 @@ static SEXP vec_rbind(SEXP xs,
     }
   }
 
-  // Must happen after the `names_to` column has been added to `ptype`
-  xs = vec_cast_common_params(xs, ptype, DF_FALLBACK_DEFAULT, S3_FALLBACK_true);
-  PROTECT_N(xs, &n_prot);
+  // When all inputs can be cast in place, the output is filled column
+  // by column straight from the inputs. Otherwise they are cast up
+  // front. Must happen after the `names_to` column has been added to
+  // `ptype`.
+  SEXP col_map = PROTECT_N(rbind_col_map(xs, ptype), &n_prot);
+
+  if (col_map == R_NilValue) {
+    xs = vec_cast_common_params(xs, ptype, DF_FALLBACK_DEFAULT, S3_FALLBACK_true);
+    PROTECT_N(xs, &n_prot);
+  }
 
   // Find individual input sizes and total size of output
   R_len_t n_rows = 0;
@@ -184,8 +194,10 @@ static SEXP vec_rbind(SEXP xs,
     init_compact_seq(p_loc, counter, size, true);
 
     // Total ownership of `out` because it was freshly created with `vec_init()`
-    out = df_assign(out, loc, x, VCTRS_OWNED_true, &bind_assign_opts);
-    REPROTECT(out, out_pi);
+    if (col_map == R_NilValue) {
+      out = df_assign(out, loc, x, VCTRS_OWNED_true, &bind_assign_opts);
+      REPROTECT(out, out_pi);
+    }
 
     if (assign_names) {
       SEXP outer = xs_is_named ? p_xs_names[i] : R_NilValue;
@@ -214,6 +226,10 @@ static SEXP vec_rbind(SEXP xs,
     counter += size;
   }
 
+  if (col_map != R_NilValue) {
+    rbind_assign_cols(out, xs, col_map, ns);
+  }
+
   if (rownames != R_NilValue) {
     Rf_setAttrib(out, R_RowNamesSymbol, rownames);
   }
@@ -245,6 +261,247 @@ static SEXP vec_rbind(SEXP xs,
   return out;
 }
 
+static bool rbind_col_is_bare(SEXP x) {
+  if (ATTRIB(x) != R_NilValue) {
+    return false;
+  }
+
+  switch (TYPEOF(x)) {
+  case LGLSXP:
+  case INTSXP:
+  case REALSXP:
+  case CPLXSXP:
+  case STRSXP:
+  case RAWSXP:
+  case VECSXP:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns `loc` if `x_col` can be assigned to `ptype_col` without a
+// full cast, `-1` if it is unspecified and there is nothing to assign
+// because the output is initialised with missing values, or `-2` if it
+// needs a full cast. Columns with names need a full cast because they
+// are only assigned by `df_assign()`.
+static int rbind_col_loc(SEXP x_col, SEXP ptype_col, int loc) {
+  if (TYPEOF(x_col) == TYPEOF(ptype_col) && ATTRIB(x_col) == R_NilValue) {
+    return loc;
+  }
+  if (Rf_getAttrib(x_col, R_NamesSymbol) != R_NilValue) {
+    return -2;
+  }
+  if (vec_can_cast_assign(x_col, ptype_col)) {
+    return loc;
+  }
+  if (TYPEOF(x_col) == LGLSXP && vec_is_unspecified(x_col)) {
+    return -1;
+  }
+  return -2;
+}
+
+/*
+ * Prepares the column-major path of `vec_rbind()`, where each output
+ * column is filled by streaming the matching column of every input
+ * straight into it, casting in place with `vec_cast_assign()`. This
+ * avoids casting every input to the common type up front.
+ *
+ * This requires a bare data frame `ptype` with bare atomic or list
+ * columns, and inputs that are `NULL`, unspecified, or bare data frames
+ * whose columns either have the type of the output column or can be
+ * losslessly cast to it in place.
+ *
+ * Returns an integer vector of size `n_cols * n_inputs` where element
+ * `j * n_inputs + i` is the 0-based location in the `i`-th input of the
+ * `j`-th column of `ptype`, or `-1` if there is nothing to assign. Returns
+ * `NULL` if any input needs a full cast.
+ */
+static SEXP rbind_col_map(SEXP xs, SEXP ptype) {
+  switch (class_type(ptype)) {
+  case vctrs_class_bare_data_frame:
+  case vctrs_class_bare_tibble:
+    break;
+  default:
+    return R_NilValue;
+  }
+
+  const R_len_t n_inputs = Rf_length(xs);
+  const R_len_t n_cols = Rf_length(ptype);
+  const SEXP* p_ptype = VECTOR_PTR_RO(ptype);
+
+  for (R_len_t j = 0; j < n_cols; ++j) {
+    if (!rbind_col_is_bare(p_ptype[j])) {
+      return R_NilValue;
+    }
+  }
+
+  SEXP ptype_names = PROTECT(r_names(ptype));
+
+  SEXP map = PROTECT(Rf_allocVector(INTSXP, n_cols * n_inputs));
+  int* p_map = INTEGER(map);
+  r_int_fill(map, -1, n_cols * n_inputs);
+
+  // Locations of the input columns in `ptype`. Reused across
+  // consecutive inputs with the same names.
+  SEXP x_locs = PROTECT(Rf_allocVector(INTSXP, n_cols));
+  int* p_x_locs = INTEGER(x_locs);
+  SEXP prev_names = R_NilValue;
+
+  for (R_len_t i = 0; i < n_inputs; ++i) {
+    SEXP x = VECTOR_ELT(xs, i);
+
+    if (x == R_NilValue) {
+      continue;
+    }
+
+    switch (class_type(x)) {
+    case vctrs_class_bare_data_frame:
+    case vctrs_class_bare_tibble:
+      break;
+    case vctrs_class_none:
+      if (vec_is_unspecified(x) && r_names(x) == R_NilValue) {
+        continue;
+      }
+      UNPROTECT(3);
+      return R_NilValue;
+    default:
+      UNPROTECT(3);
+      return R_NilValue;
+    }
+
+    const R_len_t x_n_cols = Rf_length(x);
+    if (x_n_cols > n_cols) {
+      UNPROTECT(3);
+      return R_NilValue;
+    }
+
+    SEXP x_names = r_names(x);
+
+    if (prev_names == R_NilValue || !equal_object(x_names, prev_names)) {
+      for (R_len_t k = 0; k < x_n_cols; ++k) {
+        R_len_t j = r_chr_find(ptype_names, STRING_ELT(x_names, k));
+
+        // Duplicate column names need a full cast
+        for (R_len_t l = 0; j >= 0 && l < k; ++l) {
+          if (p_x_locs[l] == j) {
+            j = -1;
+          }
+        }
+        if (j < 0) {
+          UNPROTECT(3);
+          return R_NilValue;
+        }
+
+        p_x_locs[k] = j;
+      }
+      prev_names = x_names;
+    }
+
+    const SEXP* p_x = VECTOR_PTR_RO(x);
+
+    for (R_len_t k = 0; k < x_n_cols; ++k) {
+      const R_len_t j = p_x_locs[k];
+      const int loc = rbind_col_loc(p_x[k], p_ptype[j], k);
+
+      if (loc == -2) {
+        UNPROTECT(3);
+        return R_NilValue;
+      }
+
+      p_map[j * n_inputs + i] = loc;
+    }
+  }
+
+  UNPROTECT(3);
+  return map;
+}
+
+/*
+ * Fills the columns of `out`, freshly created with `vec_init()`, one
+ * at a time from the inputs located by `map`. Columns of the same type
+ * as the output are copied directly, others are cast in place.
+ */
+static void rbind_assign_cols(SEXP out, SEXP xs, SEXP map, const int* ns) {
+  const R_len_t n_inputs = Rf_length(xs);
+  const R_len_t n_cols = Rf_length(out);
+  const int* p_map = INTEGER_RO(map);
+
+  SEXP loc = PROTECT(compact_seq(0, 0, true));
+  int* p_loc = INTEGER(loc);
+
+  const struct vec_assign_opts assign_opts = {
+    .assign_names = false
+  };
+
+  for (R_len_t j = 0; j < n_cols; ++j) {
+    SEXP out_col = VECTOR_ELT(out, j);
+    const SEXPTYPE type = TYPEOF(out_col);
+    const int* p_col_map = p_map + j * n_inputs;
+
+    // Compact sequences use 0-based counters
+    R_len_t counter = 0;
+
+    for (R_len_t i = 0; i < n_inputs; ++i) {
+      const R_len_t size = ns[i];
+      const int k = p_col_map[i];
+
+      if (size == 0) {
+        continue;
+      }
+      if (k < 0) {
+        counter += size;
+        continue;
+      }
+
+      SEXP x_col = VECTOR_ELT(VECTOR_ELT(xs, i), k);
+
+      if (TYPEOF(x_col) != type || ATTRIB(x_col) != R_NilValue) {
+        init_compact_seq(p_loc, counter, size, true);
+
+        if (!vec_cast_assign(out_col, loc, x_col)) {
+          // Corrupt factors are reported by the regular cast
+          x_col = PROTECT(vec_cast(x_col, out_col, args_empty, args_empty));
+          out_col = vec_proxy_assign_opts(out_col, loc, x_col, VCTRS_OWNED_true, &assign_opts);
+          SET_VECTOR_ELT(out, j, out_col);
+          UNPROTECT(1);
+        }
+
+        counter += size;
+        continue;
+      }
+
+      switch (type) {
+      case LGLSXP: memcpy(LOGICAL(out_col) + counter, LOGICAL_RO(x_col), size * sizeof(int)); break;
+      case INTSXP: memcpy(INTEGER(out_col) + counter, INTEGER_RO(x_col), size * sizeof(int)); break;
+      case REALSXP: memcpy(REAL(out_col) + counter, REAL_RO(x_col), size * sizeof(double)); break;
+      case CPLXSXP: memcpy(COMPLEX(out_col) + counter, COMPLEX_RO(x_col), size * sizeof(Rcomplex)); break;
+      case RAWSXP: memcpy(RAW(out_col) + counter, RAW_RO(x_col), size * sizeof(Rbyte)); break;
+      case STRSXP: {
+        const SEXP* p_x_col = STRING_PTR_RO(x_col);
+        for (R_len_t l = 0; l < size; ++l) {
+          SET_STRING_ELT(out_col, counter + l, p_x_col[l]);
+        }
+        break;
+      }
+      case VECSXP: {
+        const SEXP* p_x_col = VECTOR_PTR_RO(x_col);
+        for (R_len_t l = 0; l < size; ++l) {
+          SET_VECTOR_ELT(out_col, counter + l, p_x_col[l]);
+        }
+        break;
+      }
+      default:
+        stop_unimplemented_type("rbind_assign_cols", type);
+      }
+
+      counter += size;
+    }
+  }
+
+  UNPROTECT(1);
+}
+
 static SEXP as_df_row(SEXP x, struct name_repair_opts* name_repair) {
   if (vec_is_unspecified(x) && r_names(x) == R_NilValue) {
     return x;
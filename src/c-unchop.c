@@ -4,6 +4,7 @@
 #include "ptype-common.h"
 #include "slice.h"
 #include "slice-assign.h"
+#include "type-factor.h"
 #include "owned.h"
 #include "utils.h"
 
@@ -39,6 +40,8 @@ static SEXP vec_unchop_fallback(SEXP ptype,
                                 const struct name_repair_opts* name_repair,
                                 enum fallback_homogeneous homogenous);
 
+static bool unchop_locs_cover(SEXP xs, SEXP locs, R_len_t out_size);
+
 static SEXP vec_unchop(SEXP xs,
                        SEXP indices,
                        SEXP ptype,
@@ -83,7 +86,33 @@ static SEXP vec_unchop(SEXP xs,
     return R_NilValue;
   }
 
-  xs = PROTECT(vec_cast_common(xs, ptype));
+  // Inputs that can be widened by `vec_cast_assign()` are cast straight
+  // into the output later on, which avoids a cast copy of each of them
+  xs = PROTECT(r_clone_referenced(xs));
+
+  struct fct_recode_cache fct_cache = new_fct_recode_cache();
+  PROTECT_WITH_INDEX(fct_cache.shelter, &fct_cache.shelter_pi);
+
+  for (R_len_t i = 0; i < xs_size; ++i) {
+    SEXP x = VECTOR_ELT(xs, i);
+
+    if (vec_can_cast_assign(x, ptype)) {
+      continue;
+    }
+
+    struct cast_opts opts = {
+      .x = x,
+      .to = ptype,
+      .fallback = {
+        .df = DF_FALLBACK_DEFAULT,
+        .s3 = S3_FALLBACK_DEFAULT
+      },
+      .p_fct_cache = &fct_cache
+    };
+    SET_VECTOR_ELT(xs, i, vec_cast_opts(&opts));
+  }
+
+  UNPROTECT(1);
 
   bool assign_names = !Rf_inherits(name_spec, "rlang_zap");
   SEXP xs_names = PROTECT(r_names(xs));
@@ -113,7 +142,13 @@ static SEXP vec_unchop(SEXP xs,
   PROTECT_INDEX proxy_pi;
   PROTECT_WITH_INDEX(proxy, &proxy_pi);
 
-  proxy = vec_init(proxy, out_size);
+  // Only skip initialization with missing values when `indices` assign
+  // every location of the output
+  SEXP init = vec_init_uninitialized(proxy, out_size);
+  if (init == R_NilValue || !unchop_locs_cover(xs, locs, out_size)) {
+    init = vec_init(proxy, out_size);
+  }
+  proxy = init;
   REPROTECT(proxy, proxy_pi);
 
   SEXP out_names = R_NilValue;
@@ -155,6 +190,16 @@ static SEXP vec_unchop(SEXP xs,
     }
 
     // Total ownership of `proxy` because it was freshly created with `vec_init()`
+    if (vec_can_cast_assign(x, ptype)) {
+      if (vec_cast_assign(proxy, loc, x)) {
+        continue;
+      }
+
+      // Corrupt factors are reported by the regular cast
+      x = vec_cast(x, ptype, args_empty, args_empty);
+      SET_VECTOR_ELT(xs, i, x);
+    }
+
     proxy = vec_proxy_assign_opts(proxy, loc, x, VCTRS_OWNED_true, &unchop_assign_opts);
     REPROTECT(proxy, proxy_pi);
   }
@@ -178,6 +223,49 @@ static SEXP vec_unchop(SEXP xs,
   return out;
 }
 
+/*
+ * The locations of the non-`NULL` elements of `xs` add up to `out_size`, so
+ * they cover the whole output exactly when none of them is missing or
+ * duplicated.
+ */
+static
+bool unchop_locs_cover(SEXP xs, SEXP locs, R_len_t out_size) {
+  SEXP seen = PROTECT(r_alloc_raw0(out_size));
+  Rbyte* p_seen = RAW(seen);
+
+  R_len_t xs_size = Rf_length(xs);
+
+  for (R_len_t i = 0; i < xs_size; ++i) {
+    if (VECTOR_ELT(xs, i) == R_NilValue) {
+      continue;
+    }
+
+    SEXP loc = VECTOR_ELT(locs, i);
+
+    if (is_compact_seq(loc)) {
+      UNPROTECT(1);
+      return false;
+    }
+
+    const int* p_loc = INTEGER_RO(loc);
+    R_len_t size = Rf_length(loc);
+
+    for (R_len_t j = 0; j < size; ++j) {
+      const int elt = p_loc[j];
+
+      if (elt == NA_INTEGER || p_seen[elt - 1]) {
+        UNPROTECT(1);
+        return false;
+      }
+
+      p_seen[elt - 1] = 1;
+    }
+  }
+
+  UNPROTECT(1);
+  return true;
+}
+
 // This is essentially:
 // vec_slice_fallback(vec_c_fallback_invoke(!!!x), order(vec_c(!!!indices)))
 // with recycling of each element of `x` to the corresponding index size
@@ -3,6 +3,7 @@
 #include "c.h"
 #include "ptype-common.h"
 #include "slice-assign.h"
+#include "type-factor.h"
 #include "owned.h"
 #include "utils.h"
 
@@ -96,7 +97,12 @@ SEXP vec_c_opts(SEXP xs,
     p_sizes[i] = size;
   }
 
-  SEXP out = vec_init(ptype, out_size);
+  // Every element of `out` is assigned below, so it doesn't need to be
+  // initialized with missing values when the type allows it
+  SEXP out = vec_init_uninitialized(ptype, out_size);
+  if (out == R_NilValue) {
+    out = vec_init(ptype, out_size);
+  }
   PROTECT_INDEX out_pi;
   PROTECT_WITH_INDEX(out, &out_pi);
 
@@ -122,6 +128,9 @@ SEXP vec_c_opts(SEXP xs,
     .ignore_outer_names = true
   };
 
+  struct fct_recode_cache fct_cache = new_fct_recode_cache();
+  PROTECT_WITH_INDEX(fct_cache.shelter, &fct_cache.shelter_pi);
+
   for (R_len_t i = 0; i < n; ++i) {
     SEXP x = VECTOR_ELT(xs, i);
     R_len_t size = p_sizes[i];
@@ -151,10 +160,19 @@ SEXP vec_c_opts(SEXP xs,
       continue;
     }
 
+    // Bare atomic inputs are cast straight into `out`, which we own,
+    // when the common type is itself bare. Other types might implement
+    // their own `vec_cast()` methods even when their proxy is bare.
+    if (vec_can_cast_assign(x, ptype) && vec_cast_assign(out, loc, x)) {
+      counter += size;
+      continue;
+    }
+
     struct cast_opts opts = (struct cast_opts) {
       .x = x,
       .to = ptype,
-      .fallback = *fallback_opts
+      .fallback = *fallback_opts,
+      .p_fct_cache = &fct_cache
     };
     x = PROTECT(vec_cast_opts(&opts));
 
@@ -179,7 +197,7 @@ SEXP vec_c_opts(SEXP xs,
     out = vec_set_names(out, R_NilValue);
   }
 
-  UNPROTECT(8);
+  UNPROTECT(9);
   return out;
 }
 
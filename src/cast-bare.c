@@ -1,5 +1,6 @@
 #include <rlang.h>
 #include "vctrs.h"
+#include "dim.h"
 #include "type-data-frame.h"
 #include "utils.h"
 
@@ -190,3 +191,183 @@ SEXP int_as_double(SEXP x, bool* lossy) {
   UNPROTECT(1);
   return out;
 }
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Cast-and-assign kernels. These convert bare atomic vectors, and factors
+ * to character, straight into the destination proxy of `vec_c()` and
+ * `vec_unchop()`, without materializing a cast copy of each input first.
+ */
+
+enum cast_assign_type {
+  CAST_ASSIGN_unsupported = 0,
+  CAST_ASSIGN_logical,
+  CAST_ASSIGN_integer,
+  CAST_ASSIGN_double,
+  CAST_ASSIGN_character,
+  CAST_ASSIGN_factor
+};
+
+static inline
+enum cast_assign_type cast_assign_type(SEXP x) {
+  if (has_dim(x)) {
+    return CAST_ASSIGN_unsupported;
+  }
+
+  if (OBJECT(x)) {
+    switch (class_type(x)) {
+    case vctrs_class_bare_factor:
+    case vctrs_class_bare_ordered: return CAST_ASSIGN_factor;
+    default: return CAST_ASSIGN_unsupported;
+    }
+  }
+
+  switch (TYPEOF(x)) {
+  case LGLSXP: return CAST_ASSIGN_logical;
+  case INTSXP: return CAST_ASSIGN_integer;
+  case REALSXP: return CAST_ASSIGN_double;
+  case STRSXP: return CAST_ASSIGN_character;
+  default: return CAST_ASSIGN_unsupported;
+  }
+}
+
+/*
+ * Can `x` be cast to `to` by `vec_cast_assign()`? Only casts that can never
+ * lose information are supported, i.e. the widening casts from logical to
+ * integer or double, from integer to double, and from factor to character.
+ */
+// [[ include("cast.h") ]]
+bool vec_can_cast_assign(SEXP x, SEXP to) {
+  const enum cast_assign_type x_type = cast_assign_type(x);
+  const enum cast_assign_type to_type = cast_assign_type(to);
+
+  switch (to_type) {
+  case CAST_ASSIGN_integer:
+    return x_type == CAST_ASSIGN_logical;
+  case CAST_ASSIGN_double:
+    return x_type == CAST_ASSIGN_logical || x_type == CAST_ASSIGN_integer;
+  case CAST_ASSIGN_character:
+    return x_type == CAST_ASSIGN_factor;
+  default:
+    return false;
+  }
+}
+
+// Each `CONVERT(ELT, DST)` assigns `DST` from `ELT`
+#define CAST_ASSIGN_LGL_TO_INT(ELT, DST) DST = ELT
+
+#define CAST_ASSIGN_INT_TO_DBL(ELT, DST) \
+  DST = (ELT == NA_INTEGER) ? NA_REAL : ELT
+
+#define CAST_ASSIGN(OUT_CTYPE, OUT_DEREF, X_CTYPE, X_CONST_DEREF, CONVERT) do { \
+  OUT_CTYPE* p_out = OUT_DEREF(out);                                   \
+  const X_CTYPE* p_x = X_CONST_DEREF(x);                               \
+  const int* p_index = INTEGER_RO(index);                              \
+                                                                       \
+  if (is_compact_seq(index)) {                                         \
+    R_len_t loc = p_index[0];                                          \
+    const R_len_t size = p_index[1];                                   \
+    const R_len_t step = p_index[2];                                   \
+                                                                       \
+    for (R_len_t i = 0; i < size; ++i, loc += step) {                  \
+      const X_CTYPE elt = p_x[i];                                      \
+      CONVERT(elt, p_out[loc]);                                        \
+    }                                                                  \
+  } else {                                                             \
+    const R_len_t size = Rf_length(index);                             \
+                                                                       \
+    for (R_len_t i = 0; i < size; ++i) {                               \
+      const int loc = p_index[i];                                      \
+      if (loc == NA_INTEGER) {                                         \
+        continue;                                                      \
+      }                                                                \
+      const X_CTYPE elt = p_x[i];                                      \
+      CONVERT(elt, p_out[loc - 1]);                                    \
+    }                                                                  \
+  }                                                                    \
+} while (0)
+
+static bool fct_cast_assign_character(SEXP out, SEXP index, SEXP x);
+
+/*
+ * Casts `x` to the type of the bare atomic `out` and assigns it at `index`,
+ * in place. `index` is either a compact sequence or a vector of 1-based
+ * locations, and `x` must already be recycled to its size. `out` must be
+ * owned by the caller.
+ *
+ * Returns `false` if the types are not supported or if `x` is a corrupt
+ * factor. In that case `out` might have been partially written and the
+ * caller should overwrite the same locations through `vec_cast()` and
+ * `vec_proxy_assign()`, which also reports the error.
+ */
+// [[ include("cast.h") ]]
+bool vec_cast_assign(SEXP out, SEXP index, SEXP x) {
+  if (!vec_can_cast_assign(x, out)) {
+    return false;
+  }
+
+  switch (TYPEOF(out)) {
+  case INTSXP:
+    CAST_ASSIGN(int, INTEGER, int, LOGICAL_RO, CAST_ASSIGN_LGL_TO_INT);
+    return true;
+  case REALSXP:
+    if (TYPEOF(x) == LGLSXP) {
+      CAST_ASSIGN(double, REAL, int, LOGICAL_RO, CAST_ASSIGN_INT_TO_DBL);
+    } else {
+      CAST_ASSIGN(double, REAL, int, INTEGER_RO, CAST_ASSIGN_INT_TO_DBL);
+    }
+    return true;
+  case STRSXP:
+    return fct_cast_assign_character(out, index, x);
+  default:
+    stop_unimplemented_type("vec_cast_assign", TYPEOF(out));
+  }
+}
+
+#undef CAST_ASSIGN
+#undef CAST_ASSIGN_LGL_TO_INT
+#undef CAST_ASSIGN_INT_TO_DBL
+
+// Corrupt factors are left to `fct_as_character()` to report
+static
+bool fct_cast_assign_character(SEXP out, SEXP index, SEXP x) {
+  SEXP levels = Rf_getAttrib(x, R_LevelsSymbol);
+
+  if (TYPEOF(levels) != STRSXP) {
+    return false;
+  }
+
+  const SEXP* p_levels = STRING_PTR_RO(levels);
+  const int n_levels = Rf_length(levels);
+
+  const int* p_x = INTEGER_RO(x);
+  const int* p_index = INTEGER_RO(index);
+
+  const bool compact = is_compact_seq(index);
+  const R_len_t size = compact ? p_index[1] : Rf_length(index);
+  const R_len_t step = compact ? p_index[2] : 0;
+  R_len_t loc = compact ? p_index[0] : 0;
+
+  for (R_len_t i = 0; i < size; ++i, loc += step) {
+    if (!compact) {
+      loc = p_index[i];
+      if (loc == NA_INTEGER) {
+        continue;
+      }
+      --loc;
+    }
+
+    const int code = p_x[i];
+
+    if (code == NA_INTEGER) {
+      SET_STRING_ELT(out, loc, NA_STRING);
+    } else if (code < 1 || code > n_levels) {
+      return false;
+    } else {
+      SET_STRING_ELT(out, loc, p_levels[code - 1]);
+    }
+  }
+
+  return true;
+}
@@ -35,7 +35,7 @@ SEXP vec_cast_dispatch_native(const struct cast_opts* opts,
     }
 
   case vctrs_type2_s3_bare_factor_bare_factor:
-    return fct_as_factor(x, to, lossy, x_arg, to_arg);
+    return fct_as_factor(x, to, lossy, x_arg, to_arg, opts->p_fct_cache);
 
   case vctrs_type2_s3_bare_ordered_bare_ordered:
     return ord_as_ordered(opts);
@@ -5,6 +5,7 @@
 #include "ptype2.h"
 #include "ptype-common.h"
 #include "type-data-frame.h"
+#include "type-factor.h"
 #include "utils.h"
 
 static
@@ -234,12 +235,16 @@ SEXP vec_cast_common_opts(SEXP xs,
   R_len_t n = Rf_length(xs);
   SEXP out = PROTECT(Rf_allocVector(VECSXP, n));
 
+  struct fct_recode_cache fct_cache = new_fct_recode_cache();
+  PROTECT_WITH_INDEX(fct_cache.shelter, &fct_cache.shelter_pi);
+
   for (R_len_t i = 0; i < n; ++i) {
     SEXP elt = VECTOR_ELT(xs, i);
     struct cast_opts opts = {
       .x = elt,
       .to = type,
-      .fallback = *fallback_opts
+      .fallback = *fallback_opts,
+      .p_fct_cache = &fct_cache
     };
     SET_VECTOR_ELT(out, i, vec_cast_opts(&opts));
   }
@@ -247,7 +252,7 @@ SEXP vec_cast_common_opts(SEXP xs,
   SEXP names = PROTECT(Rf_getAttrib(xs, R_NamesSymbol));
   Rf_setAttrib(out, R_NamesSymbol, names);
 
-  UNPROTECT(3);
+  UNPROTECT(4);
   return out;
 }
 // [[ include("cast.h") ]]
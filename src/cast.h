@@ -3,12 +3,20 @@
 
 #include "ptype2.h"
 
+// Defined in type-factor.h
+struct fct_recode_cache;
+
+/*
+ * @member p_fct_cache Optional cache of factor level recodings, shared by
+ *   the casts of one operation. Can be `NULL`.
+ */
 struct cast_opts {
   SEXP x;
   SEXP to;
   struct vctrs_arg* x_arg;
   struct vctrs_arg* to_arg;
   struct fallback_opts fallback;
+  struct fct_recode_cache* p_fct_cache;
 };
 
 SEXP df_cast_opts(const struct cast_opts* opts);
@@ -83,6 +91,8 @@ SEXP lgl_as_integer(SEXP x, bool* lossy);
 SEXP chr_as_logical(SEXP x, bool* lossy);
 SEXP dbl_as_logical(SEXP x, bool* lossy);
 SEXP int_as_logical(SEXP x, bool* lossy);
+bool vec_can_cast_assign(SEXP x, SEXP to);
+bool vec_cast_assign(SEXP out, SEXP index, SEXP x);
 
 
 #endif
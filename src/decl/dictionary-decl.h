@@ -1 +1 @@
-static inline uint32_t dict_key_size(SEXP x);
+static inline uint64_t dict_key_size(SEXP x);
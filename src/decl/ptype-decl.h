@@ -1,2 +1,6 @@
 static inline SEXP vec_ptype_method(SEXP x);
 static inline SEXP vec_ptype_invoke(SEXP x, SEXP method);
+
+static bool ptype_fingerprint_equal(SEXP x, SEXP y);
+static bool bare_fingerprint_equal(SEXP x, SEXP y);
+static inline bool attrib_only_names(SEXP attrib);
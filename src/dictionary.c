@@ -5,6 +5,8 @@
 #include "equal.h"
 #include "hash.h"
 #include "ptype2.h"
+#include "dim.h"
+#include "order-radix.h"
 #include "utils.h"
 
 #include "decl/dictionary-decl.h"
@@ -16,7 +18,7 @@ struct vctrs_arg args_haystack;
 
 // http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2
 static inline
-uint32_t u32_safe_ceil2(uint32_t x) {
+uint64_t u64_safe_ceil2(uint64_t x) {
   // Return 2^0 when `x` is 0
   x += (x == 0);
 
@@ -26,13 +28,13 @@ uint32_t u32_safe_ceil2(uint32_t x) {
   x |= x >> 4;
   x |= x >> 8;
   x |= x >> 16;
+  x |= x >> 32;
   x++;
 
   if (x == 0) {
-    // INT32_MAX+2 <= x <= UINT32_MAX (i.e. 2^31+1 <= x <= 2^32-1) would attempt
-    // to ceiling to 2^32, which is 1 greater than `UINT32_MAX`, resulting in
-    // overflow wraparound to 0.
-    r_stop_internal("u32_safe_ceil2", "`x` results in an `uint32_t` overflow.");
+    // 2^63+1 <= x <= UINT64_MAX would attempt to ceiling to 2^64,
+    // resulting in overflow wraparound to 0.
+    r_stop_internal("u64_safe_ceil2", "`x` results in an `uint64_t` overflow.");
   }
 
   return x;
@@ -41,6 +43,7 @@ uint32_t u32_safe_ceil2(uint32_t x) {
 // Dictonary object ------------------------------------------------------------
 
 static struct dictionary* new_dictionary_opts(SEXP x, struct dictionary_opts* opts);
+static struct dictionary* new_dictionary_from(SEXP x, SEXP key, SEXP hash);
 
 // Dictionaries must be protected in consistent stack order with
 // `PROTECT_DICT()`
@@ -69,10 +72,50 @@ static struct dictionary* new_dictionary_params(SEXP x, bool partial, bool na_eq
 static struct dictionary* new_dictionary_opts(SEXP x, struct dictionary_opts* opts) {
   int nprot = 0;
 
-  SEXP out = PROTECT_N(Rf_allocVector(RAWSXP, sizeof(struct dictionary)), &nprot);
-  struct dictionary* d = (struct dictionary*) RAW(out);
+  SEXP key = R_NilValue;
 
-  d->protect = out;
+  if (!opts->partial) {
+    uint64_t size = dict_key_size(x);
+
+    key = PROTECT_N(Rf_allocVector(RAWSXP, size * sizeof(struct dictionary_slot)), &nprot);
+
+    // Sets all keys to `DICT_EMPTY`. The hash of empty slots is unused.
+    memset(RAW(key), DICT_EMPTY, size * sizeof(struct dictionary_slot));
+  }
+
+  SEXP hash = R_NilValue;
+
+  R_len_t n = vec_size(x);
+  if (n) {
+    hash = PROTECT_N(Rf_allocVector(RAWSXP, n * sizeof(uint32_t)), &nprot);
+    uint32_t* p_hash = (uint32_t*) RAW(hash);
+
+    memset(p_hash, 0, n * sizeof(uint32_t));
+    hash_fill(p_hash, n, x, opts->na_equal);
+  }
+
+  struct dictionary* d = new_dictionary_from(x, key, hash);
+
+  UNPROTECT(nprot);
+  return d;
+}
+
+// Wraps preallocated `key` and `hash` vectors. These are kept alive
+// by the dictionary's `protect` shelter so that they can outlive
+// the dictionary (see `vctrs_new_dictionary()`).
+static struct dictionary* new_dictionary_from(SEXP x, SEXP key, SEXP hash) {
+  int nprot = 0;
+
+  SEXP shelter = PROTECT_N(Rf_allocVector(VECSXP, 3), &nprot);
+
+  SEXP self = Rf_allocVector(RAWSXP, sizeof(struct dictionary));
+  SET_VECTOR_ELT(shelter, 0, self);
+  SET_VECTOR_ELT(shelter, 1, key);
+  SET_VECTOR_ELT(shelter, 2, hash);
+
+  struct dictionary* d = (struct dictionary*) RAW(self);
+
+  d->protect = shelter;
 
   enum vctrs_type type = vec_proxy_typeof(x);
 
@@ -85,30 +128,18 @@ static struct dictionary* new_dictionary_opts(SEXP x, struct dictionary_opts* op
 
   d->used = 0;
 
-  if (opts->partial) {
-    d->key = NULL;
+  if (key == R_NilValue) {
+    d->slots = NULL;
     d->size = 0;
   } else {
-    uint32_t size = dict_key_size(x);
-
-    d->key = (R_len_t*) R_alloc(size, sizeof(R_len_t));
-    memset(d->key, DICT_EMPTY, size * sizeof(R_len_t));
-
-    d->size = size;
+    d->slots = (struct dictionary_slot*) RAW(key);
+    d->size = Rf_xlength(key) / sizeof(struct dictionary_slot);
   }
 
-  R_len_t n = vec_size(x);
-  if (n) {
-    d->hash = (uint32_t*) R_alloc(n, sizeof(uint32_t));
-
-    if (!(d->hash)) {
-      Rf_errorcall(R_NilValue, "Can't allocate hash lookup table. Please free memory.");
-    }
-
-    memset(d->hash, 0, n * sizeof(R_len_t));
-    hash_fill(d->hash, n, x, opts->na_equal);
-  } else {
+  if (hash == R_NilValue) {
     d->hash = NULL;
+  } else {
+    d->hash = (uint32_t*) RAW(hash);
   }
 
   UNPROTECT(nprot);
@@ -125,10 +156,16 @@ uint32_t dict_hash_with(struct dictionary* d, struct dictionary* x, R_len_t i) {
   const void* p_d_vec = d->p_poly_vec->p_vec;
   const void* p_x_vec = x->p_poly_vec->p_vec;
 
+  const uint64_t mask = d->size - 1;
+
   // Quadratic probing: will try every slot if d->size is power of 2
   // http://research.cs.vt.edu/AVresearch/hashing/quadratic.php
-  for (uint32_t k = 0; k < d->size; ++k) {
-    uint32_t probe = (hash + k * (k + 1) / 2) & (d->size - 1);
+  //
+  // The probe sequence is computed in 64-bit so that tables of 2^32
+  // slots can be traversed without the triangular numbers wrapping
+  // around before being masked. Slots themselves fit in a `uint32_t`.
+  for (uint64_t k = 0; k < d->size; ++k) {
+    uint32_t probe = (hash + k * (k + 1) / 2) & mask;
     // Rprintf("Probe: %i\n", probe);
 
     // If we circled back to start, dictionary is full
@@ -136,12 +173,20 @@ uint32_t dict_hash_with(struct dictionary* d, struct dictionary* x, R_len_t i) {
       break;
     }
 
+    const struct dictionary_slot slot = d->slots[probe];
+
     // Check for unused slot
-    R_len_t idx = d->key[probe];
+    R_len_t idx = slot.key;
     if (idx == DICT_EMPTY) {
       return probe;
     }
 
+    // Equal values have equal hashes. Comparing the full hash stored
+    // in the slot rejects most collisions without touching the data.
+    if (slot.hash != hash) {
+      continue;
+    }
+
     // Check for same value as there might be a collision
     if (d->p_equal_na_equal(p_d_vec, idx, p_x_vec, i)) {
       return probe;
@@ -165,24 +210,25 @@ bool dict_is_missing(struct dictionary* d, R_len_t i) {
 
 
 void dict_put(struct dictionary* d, uint32_t hash, R_len_t i) {
-  d->key[hash] = i;
+  d->slots[hash].key = i;
+  d->slots[hash].hash = d->hash[i];
   d->used++;
 }
 
 // Assume worst case, that every value is distinct, aiming for a load factor
 // of at most 77%. We round up to power of 2 to ensure quadratic probing
-// strategy works. Maximum power of 2 we can store in a uint32_t is 2^31,
-// as 2^32 is 1 greater than the max uint32_t value, so we clamp sizes that
-// would result in 2^32 to INT32_MAX to ensure that our maximum ceiling value
-// is only 2^31. This will increase the load factor above 77% for `x` with
-// length greater than 1653562409 (2147483648 * .77), but it ensures that
-// it can run.
+// strategy works. The table size is computed in 64-bit, so that inputs
+// with more than 1653562409 (2147483648 * .77) elements get a table of
+// 2^32 slots rather than being clamped to 2^31 slots at the cost of a
+// higher load factor. Since hashes are 32-bit, 2^32 is the maximum
+// number of slots, which is enough for any `R_len_t` input.
 static inline
-uint32_t dict_key_size(SEXP x) {
-  const R_len_t x_size = vec_size(x);
+uint64_t dict_key_size(SEXP x) {
+  const r_ssize x_size = vec_size(x);
 
   if (x_size > R_LEN_T_MAX) {
-    // Ensure we catch the switch to supporting long vectors in `vec_size()`
+    // Keys are `R_len_t` locations. Ensure we catch the switch to
+    // supporting long vectors in `vec_size()`.
     r_stop_internal("dict_key_size", "Dictionary functions do not support long vectors.");
   }
 
@@ -192,27 +238,428 @@ uint32_t dict_key_size(SEXP x) {
     r_stop_internal("dict_key_size", "Can't safely cast load adjusted size to a `uint32_t`.");
   }
 
-  uint32_t size = (uint32_t)load_adjusted_size;
-  // Clamp to `INT32_MAX` to avoid overflow in `u32_safe_ceil2()`,
-  // at the cost of an increased maximum load factor for long input
-  size = size > INT32_MAX ? INT32_MAX : size;
-  size = u32_safe_ceil2(size);
+  uint64_t size = (uint64_t) load_adjusted_size;
+  size = u64_safe_ceil2(size);
   size = (size < 16) ? 16 : size;
 
-  if (x_size > size) {
+  if ((uint64_t) x_size > size) {
     // Should never happen with `R_len_t` sizes.
     // This is a defensive check that will be useful when we support long vectors.
     r_stop_internal("dict_key_size", "Hash table size must be at least as large as input to avoid a load factor of >100%.");
   }
 
-  // Rprintf("size: %u\n", size);
+  // Rprintf("size: %" PRIu64 "\n", size);
   return size;
 }
 
+// Dictionary handles ----------------------------------------------------------
+
+// A dictionary handle is a persistent, GC-managed dictionary that
+// has been loaded once with every element of a haystack. It can be
+// supplied as `haystack` to `vec_match()` and `vec_in()` to look up
+// needles without rehashing the haystack on every call.
+//
+// The hashes of character vectors are derived from `CHARSXP`
+// addresses, which don't survive serialisation. The `sentinel`
+// external pointer is reset to `NULL` on unserialisation, which
+// signals that the handle must be reloaded before use.
+
+enum dict_handle_elt {
+  DICT_HANDLE_haystack = 0,
+  DICT_HANDLE_ptype,
+  DICT_HANDLE_proxy,
+  DICT_HANDLE_key,
+  DICT_HANDLE_hash,
+  DICT_HANDLE_used,
+  DICT_HANDLE_sentinel,
+  DICT_HANDLE_SIZE
+};
+
+static SEXP dict_handle_names = NULL;
+static SEXP classes_vctrs_dictionary = NULL;
+
+// The address of this variable marks handles created in this session
+static int dict_handle_sentinel = 0;
+
+static void dict_handle_load(SEXP handle);
+
+// [[ register() ]]
+SEXP vctrs_new_dictionary(SEXP haystack, SEXP haystack_arg_) {
+  struct vctrs_arg haystack_arg = vec_as_arg(haystack_arg_);
+
+  if (is_dictionary_handle(haystack)) {
+    return haystack;
+  }
+
+  vec_assert(haystack, &haystack_arg);
+
+  SEXP out = PROTECT(Rf_allocVector(VECSXP, DICT_HANDLE_SIZE));
+
+  SET_VECTOR_ELT(out, DICT_HANDLE_haystack, haystack);
+  SET_VECTOR_ELT(out, DICT_HANDLE_ptype, vec_ptype(haystack, &haystack_arg));
+
+  dict_handle_load(out);
+
+  Rf_setAttrib(out, R_NamesSymbol, dict_handle_names);
+  Rf_setAttrib(out, R_ClassSymbol, classes_vctrs_dictionary);
+
+  UNPROTECT(1);
+  return out;
+}
+
+// [[ include("dictionary.h") ]]
+bool is_dictionary_handle(SEXP x) {
+  return
+    TYPEOF(x) == VECSXP &&
+    Rf_length(x) == DICT_HANDLE_SIZE &&
+    Rf_inherits(x, "vctrs_dictionary");
+}
+
+// Hashes and loads all elements of the haystack and stores the
+// resulting key and hash arrays inside the handle
+static void dict_handle_load(SEXP handle) {
+  int nprot = 0;
+
+  SEXP haystack = VECTOR_ELT(handle, DICT_HANDLE_haystack);
+  R_len_t n = vec_size(haystack);
+
+  SEXP proxy = PROTECT_N(vec_proxy_equal(haystack), &nprot);
+  proxy = PROTECT_N(vec_normalize_encoding(proxy), &nprot);
+
+  struct dictionary* d = new_dictionary(proxy);
+  PROTECT_DICT(d, &nprot);
+
+  for (R_len_t i = 0; i < n; ++i) {
+    uint32_t hash = dict_hash_scalar(d, i);
+
+    if (d->slots[hash].key == DICT_EMPTY) {
+      dict_put(d, hash, i);
+    }
+  }
+
+  SEXP sentinel = PROTECT_N(R_MakeExternalPtr(&dict_handle_sentinel, R_NilValue, R_NilValue), &nprot);
+
+  SET_VECTOR_ELT(handle, DICT_HANDLE_proxy, proxy);
+  SET_VECTOR_ELT(handle, DICT_HANDLE_key, VECTOR_ELT(d->protect, 1));
+  SET_VECTOR_ELT(handle, DICT_HANDLE_hash, VECTOR_ELT(d->protect, 2));
+  SET_VECTOR_ELT(handle, DICT_HANDLE_used, Rf_ScalarInteger(d->used));
+  SET_VECTOR_ELT(handle, DICT_HANDLE_sentinel, sentinel);
+
+  UNPROTECT(nprot);
+}
+
+static inline
+bool dict_handle_is_stale(SEXP handle) {
+  SEXP sentinel = VECTOR_ELT(handle, DICT_HANDLE_sentinel);
+  return
+    TYPEOF(sentinel) != EXTPTRSXP ||
+    R_ExternalPtrAddr(sentinel) != &dict_handle_sentinel;
+}
+
+/**
+ * Create a loaded dictionary from a handle
+ *
+ * The returned dictionary shares the key and hash arrays of the
+ * handle, so it must not be modified with `dict_put()`. A handle that
+ * was unserialised is reloaded in place first. Must be protected with
+ * `PROTECT_DICT()`.
+ */
+// [[ include("dictionary.h") ]]
+struct dictionary* dict_from_handle(SEXP handle) {
+  if (dict_handle_is_stale(handle)) {
+    dict_handle_load(handle);
+  }
+
+  struct dictionary* d = new_dictionary_from(
+    VECTOR_ELT(handle, DICT_HANDLE_proxy),
+    VECTOR_ELT(handle, DICT_HANDLE_key),
+    VECTOR_ELT(handle, DICT_HANDLE_hash)
+  );
+
+  d->used = INTEGER(VECTOR_ELT(handle, DICT_HANDLE_used))[0];
+  return d;
+}
+
+static inline
+SEXP dict_handle_haystack(SEXP handle) {
+  return VECTOR_ELT(handle, DICT_HANDLE_haystack);
+}
+static inline
+SEXP dict_handle_ptype(SEXP handle) {
+  return VECTOR_ELT(handle, DICT_HANDLE_ptype);
+}
+
+
+// Engine selection ------------------------------------------------------------
+
+// Sorting only pays off for large inputs, see `bench/sorting-vs-hashing.Rmd`
+#define DICT_SORT_MIN_SIZE 10000
+#define DICT_SORT_SAMPLE_SIZE 1024
+#define DICT_SORT_MIN_INT_COLS 4
+
+static bool dict_sort_is_eligible(SEXP x);
+static bool dict_sort_predicts_win(SEXP x, R_len_t n);
+
+/*
+ * Unique values can also be found by radix ordering `x` and walking its
+ * groups. `dict_engine()` makes a cheap prediction of which approach is
+ * faster from the type of `x` and a strided sample of its values. The
+ * sort engine is only considered for types whose order proxy has the same
+ * notion of equality as their equality proxy.
+ *
+ * The `vctrs:::dictionary_engine` option forces an engine. It is meant for
+ * testing and benchmarking.
+ */
+// [[ include("dictionary.h") ]]
+enum dict_engine dict_engine(SEXP x) {
+  SEXP opt = r_peek_option("vctrs:::dictionary_engine");
+
+  if (opt != R_NilValue) {
+    if (!r_is_string(opt)) {
+      Rf_errorcall(R_NilValue, "`vctrs:::dictionary_engine` must be a string.");
+    }
+
+    const char* c_opt = CHAR(STRING_ELT(opt, 0));
+
+    if (!strcmp(c_opt, "hash")) {
+      return DICT_ENGINE_hash;
+    }
+    if (!strcmp(c_opt, "sort")) {
+      return dict_sort_is_eligible(x) ? DICT_ENGINE_sort : DICT_ENGINE_hash;
+    }
+
+    Rf_errorcall(
+      R_NilValue,
+      "`vctrs:::dictionary_engine` must be \"hash\" or \"sort\"."
+    );
+  }
+
+  R_len_t n = vec_size(x);
+
+  if (n < DICT_SORT_MIN_SIZE || !dict_sort_is_eligible(x)) {
+    return DICT_ENGINE_hash;
+  }
+
+  return dict_sort_predicts_win(x, n) ? DICT_ENGINE_sort : DICT_ENGINE_hash;
+}
+
+static
+bool dict_sort_is_eligible_col(SEXP x) {
+  switch (TYPEOF(x)) {
+  case LGLSXP:
+  case INTSXP:
+  case REALSXP:
+  case STRSXP:
+    break;
+  default:
+    return false;
+  }
+
+  if (has_dim(x)) {
+    return false;
+  }
+  if (!OBJECT(x)) {
+    return true;
+  }
+
+  // Classes whose order proxy is known to be their equality proxy.
+  // Subclasses might implement their own `vec_proxy_order()` method.
+  switch (class_type(x)) {
+  case vctrs_class_bare_factor:
+  case vctrs_class_bare_ordered:
+  case vctrs_class_bare_date:
+  case vctrs_class_bare_posixct:
+    return true;
+  default:
+    return false;
+  }
+}
+
+static
+bool dict_sort_is_eligible(SEXP x) {
+  if (!is_data_frame(x)) {
+    return dict_sort_is_eligible_col(x);
+  }
+
+  R_len_t n_cols = Rf_length(x);
+  if (n_cols == 0) {
+    return false;
+  }
+
+  for (R_len_t i = 0; i < n_cols; ++i) {
+    if (!dict_sort_is_eligible_col(VECTOR_ELT(x, i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool int_sample_is_sorted(const int* p_x, R_len_t n);
+static bool dbl_sample_is_sorted(const double* p_x, R_len_t n);
+static bool chr_sample_is_low_cardinality(const SEXP* p_x, R_len_t n);
+
+static
+bool dict_sort_predicts_win(SEXP x, R_len_t n) {
+  switch (TYPEOF(x)) {
+  case LGLSXP: return int_sample_is_sorted(LOGICAL_RO(x), n);
+  case INTSXP: return int_sample_is_sorted(INTEGER_RO(x), n);
+  case REALSXP: return dbl_sample_is_sorted(REAL_RO(x), n);
+  case STRSXP: return chr_sample_is_low_cardinality(STRING_PTR_RO(x), n);
+  case VECSXP: break;
+  default: stop_unimplemented_type("dict_sort_predicts_win", TYPEOF(x));
+  }
+
+  // Data frames with many integer columns have expensive row hashes and
+  // equality probes, whereas the radix sort refines groups one integer
+  // column at a time
+  R_len_t n_cols = Rf_length(x);
+  if (n_cols < DICT_SORT_MIN_INT_COLS) {
+    return false;
+  }
+
+  for (R_len_t i = 0; i < n_cols; ++i) {
+    switch (TYPEOF(VECTOR_ELT(x, i))) {
+    case LGLSXP:
+    case INTSXP:
+      break;
+    default:
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Sorted input is detected in linear time by `vec_order()`, which is
+// cheaper than hashing every element. Missing values don't count as sorted.
+#define SAMPLE_IS_SORTED(IS_MISSING) do {                       \
+  const R_len_t stride = n / DICT_SORT_SAMPLE_SIZE;             \
+                                                                \
+  for (R_len_t i = stride; i < n; i += stride) {                \
+    const R_len_t prev = i - stride;                            \
+                                                                \
+    if (IS_MISSING(p_x[prev]) || IS_MISSING(p_x[i])) {          \
+      return false;                                             \
+    }                                                           \
+    if (p_x[prev] > p_x[i]) {                                   \
+      return false;                                             \
+    }                                                           \
+  }                                                             \
+                                                                \
+  return true;                                                  \
+} while (0)
+
+#define INT_IS_MISSING(X) ((X) == NA_INTEGER)
+
+static
+bool int_sample_is_sorted(const int* p_x, R_len_t n) {
+  SAMPLE_IS_SORTED(INT_IS_MISSING);
+}
+static
+bool dbl_sample_is_sorted(const double* p_x, R_len_t n) {
+  SAMPLE_IS_SORTED(isnan);
+}
+
+#undef INT_IS_MISSING
+#undef SAMPLE_IS_SORTED
+
+static
+int ptr_compare(const void* x, const void* y) {
+  uintptr_t x_ = (uintptr_t) *(const SEXP*) x;
+  uintptr_t y_ = (uintptr_t) *(const SEXP*) y;
+  return (x_ > y_) - (x_ < y_);
+}
+
+// Strings are interned, so distinct pointers are distinct values. When
+// there are few of them, ordering by appearance with the `TRUELENGTH()`
+// counting sort is much cheaper than hashing every string.
+static
+bool chr_sample_is_low_cardinality(const SEXP* p_x, R_len_t n) {
+  const R_len_t stride = n / DICT_SORT_SAMPLE_SIZE;
+
+  SEXP* p_sample = (SEXP*) R_alloc(DICT_SORT_SAMPLE_SIZE, sizeof(SEXP));
+
+  for (R_len_t i = 0; i < DICT_SORT_SAMPLE_SIZE; ++i) {
+    p_sample[i] = p_x[i * stride];
+  }
+
+  qsort(p_sample, DICT_SORT_SAMPLE_SIZE, sizeof(SEXP), &ptr_compare);
+
+  R_len_t n_distinct = 1;
+  for (R_len_t i = 1; i < DICT_SORT_SAMPLE_SIZE; ++i) {
+    n_distinct += p_sample[i] != p_sample[i - 1];
+  }
+
+  return n_distinct <= DICT_SORT_SAMPLE_SIZE / 8;
+}
+
+/*
+ * Groups of the order are sorted by value rather than by appearance. The
+ * ordering is stable, so the first location in each group is the first
+ * occurrence of its key.
+ */
+// [[ include("dictionary.h") ]]
+SEXP dict_sort_info(SEXP x) {
+  const bool nan_distinct = true;
+  const bool chr_ordered = false;
+  return vec_order_info(x, chrs_asc, chrs_largest, nan_distinct, R_NilValue, chr_ordered);
+}
+
+// [[ include("dictionary.h") ]]
+SEXP dict_sort_key_groups(SEXP info, R_len_t n) {
+  const int* p_o = INTEGER_RO(VECTOR_ELT(info, 0));
+
+  SEXP sizes = VECTOR_ELT(info, 1);
+  const int* p_sizes = INTEGER_RO(sizes);
+  const R_len_t n_groups = Rf_length(sizes);
+
+  SEXP out = PROTECT(Rf_allocVector(INTSXP, n));
+  int* p_out = INTEGER(out);
+
+  for (R_len_t i = 0; i < n; ++i) {
+    p_out[i] = -1;
+  }
+
+  R_len_t start = 0;
+
+  for (R_len_t i = 0; i < n_groups; ++i) {
+    p_out[p_o[start] - 1] = i;
+    start += p_sizes[i];
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+
 // R interface -----------------------------------------------------------------
 // TODO: rename to match R function names
 // TODO: separate out into individual files
 
+static
+SEXP vec_unique_loc_sort(SEXP x, R_len_t n) {
+  SEXP info = PROTECT(dict_sort_info(x));
+  R_len_t n_groups = Rf_length(VECTOR_ELT(info, 1));
+
+  SEXP key_groups = PROTECT(dict_sort_key_groups(info, n));
+  const int* p_key_groups = INTEGER_RO(key_groups);
+
+  SEXP out = PROTECT(Rf_allocVector(INTSXP, n_groups));
+  int* p_out = INTEGER(out);
+  R_len_t k = 0;
+
+  for (R_len_t i = 0; i < n; ++i) {
+    if (p_key_groups[i] >= 0) {
+      p_out[k] = i + 1;
+      ++k;
+    }
+  }
+
+  UNPROTECT(3);
+  return out;
+}
+
 SEXP vctrs_unique_loc(SEXP x) {
   int nprot = 0;
 
@@ -221,6 +668,12 @@ SEXP vctrs_unique_loc(SEXP x) {
   x = PROTECT_N(vec_proxy_equal(x), &nprot);
   x = PROTECT_N(vec_normalize_encoding(x), &nprot);
 
+  if (dict_engine(x) == DICT_ENGINE_sort) {
+    SEXP out = vec_unique_loc_sort(x, n);
+    UNPROTECT(nprot);
+    return out;
+  }
+
   struct dictionary* d = new_dictionary(x);
   PROTECT_DICT(d, &nprot);
 
@@ -230,7 +683,7 @@ SEXP vctrs_unique_loc(SEXP x) {
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
       growable_push_int(&g, i + 1);
     }
@@ -272,7 +725,7 @@ bool duplicated_any(SEXP x) {
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
     } else {
       out = true;
@@ -292,13 +745,20 @@ SEXP vctrs_n_distinct(SEXP x) {
   x = PROTECT_N(vec_proxy_equal(x), &nprot);
   x = PROTECT_N(vec_normalize_encoding(x), &nprot);
 
+  if (dict_engine(x) == DICT_ENGINE_sort) {
+    SEXP info = PROTECT_N(dict_sort_info(x), &nprot);
+    R_len_t n_groups = Rf_length(VECTOR_ELT(info, 1));
+    UNPROTECT(nprot);
+    return Rf_ScalarInteger(n_groups);
+  }
+
   struct dictionary* d = new_dictionary(x);
   PROTECT_DICT(d, &nprot);
 
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
     }
   }
@@ -324,10 +784,10 @@ SEXP vctrs_id(SEXP x) {
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
     }
-    p_out[i] = d->key[hash] + 1;
+    p_out[i] = d->slots[hash].key + 1;
   }
 
   UNPROTECT(nprot);
@@ -347,6 +807,11 @@ SEXP vctrs_match(SEXP needles, SEXP haystack, SEXP na_equal,
                           &haystack_arg);
 }
 
+static struct dictionary* dict_prepare_haystack(SEXP haystack,
+                                                SEXP handle,
+                                                SEXP type,
+                                                bool na_equal,
+                                                struct vctrs_arg* haystack_arg);
 static inline void vec_match_loop(int* p_out,
                                   struct dictionary* d,
                                   struct dictionary* d_needles,
@@ -362,6 +827,13 @@ SEXP vec_match_params(SEXP needles,
                       struct vctrs_arg* needles_arg,
                       struct vctrs_arg* haystack_arg) {
   int nprot = 0;
+
+  SEXP handle = R_NilValue;
+  if (is_dictionary_handle(haystack)) {
+    handle = haystack;
+    haystack = dict_handle_ptype(handle);
+  }
+
   int _;
   SEXP type = vec_ptype2_params(needles, haystack,
                                 needles_arg, haystack_arg,
@@ -375,20 +847,61 @@ SEXP vec_match_params(SEXP needles,
                             S3_FALLBACK_false);
   PROTECT_N(needles, &nprot);
 
+  needles = PROTECT_N(vec_proxy_equal(needles), &nprot);
+  needles = PROTECT_N(vec_normalize_encoding(needles), &nprot);
+
+  R_len_t n_needle = vec_size(needles);
+
+  struct dictionary* d = dict_prepare_haystack(haystack, handle, type, na_equal, haystack_arg);
+  PROTECT_DICT(d, &nprot);
+
+  struct dictionary* d_needles = new_dictionary_params(needles, true, na_equal);
+  PROTECT_DICT(d_needles, &nprot);
+
+  // Locate needles
+  SEXP out = PROTECT_N(Rf_allocVector(INTSXP, n_needle), &nprot);
+  int* p_out = INTEGER(out);
+
+  if (na_equal) {
+    vec_match_loop(p_out, d, d_needles, n_needle);
+  } else {
+    vec_match_loop_propagate(p_out, d, d_needles, n_needle);
+  }
+
+  UNPROTECT(nprot);
+  return out;
+}
+
+// Returns a dictionary loaded with all elements of `haystack`. When a
+// dictionary handle was supplied, and `type` is the same as the type
+// of its haystack, the precomputed dictionary is used as is.
+// Otherwise the haystack is cast to `type` and hashed from scratch.
+//
+// The returned dictionary must be protected with `PROTECT_DICT()`.
+static struct dictionary* dict_prepare_haystack(SEXP haystack,
+                                                SEXP handle,
+                                                SEXP type,
+                                                bool na_equal,
+                                                struct vctrs_arg* haystack_arg) {
+  if (handle != R_NilValue) {
+    if (equal_object(type, dict_handle_ptype(handle))) {
+      return dict_from_handle(handle);
+    }
+    haystack = dict_handle_haystack(handle);
+  }
+
+  int nprot = 0;
+
   haystack = vec_cast_params(haystack, type,
                              haystack_arg, args_empty,
                              DF_FALLBACK_quiet,
                              S3_FALLBACK_false);
   PROTECT_N(haystack, &nprot);
 
-  needles = PROTECT_N(vec_proxy_equal(needles), &nprot);
-  needles = PROTECT_N(vec_normalize_encoding(needles), &nprot);
-
   haystack = PROTECT_N(vec_proxy_equal(haystack), &nprot);
   haystack = PROTECT_N(vec_normalize_encoding(haystack), &nprot);
 
   R_len_t n_haystack = vec_size(haystack);
-  R_len_t n_needle = vec_size(needles);
 
   struct dictionary* d = new_dictionary_params(haystack, false, na_equal);
   PROTECT_DICT(d, &nprot);
@@ -397,26 +910,13 @@ SEXP vec_match_params(SEXP needles,
   for (int i = 0; i < n_haystack; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
     }
   }
 
-  struct dictionary* d_needles = new_dictionary_params(needles, true, na_equal);
-  PROTECT_DICT(d_needles, &nprot);
-
-  // Locate needles
-  SEXP out = PROTECT_N(Rf_allocVector(INTSXP, n_needle), &nprot);
-  int* p_out = INTEGER(out);
-
-  if (na_equal) {
-    vec_match_loop(p_out, d, d_needles, n_needle);
-  } else {
-    vec_match_loop_propagate(p_out, d, d_needles, n_needle);
-  }
-
   UNPROTECT(nprot);
-  return out;
+  return d;
 }
 
 static inline void vec_match_loop(int* p_out,
@@ -426,11 +926,11 @@ static inline void vec_match_loop(int* p_out,
   for (R_len_t i = 0; i < n_needle; ++i) {
     uint32_t hash = dict_hash_with(d, d_needles, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       // TODO: Return `no_match` instead
       p_out[i] = NA_INTEGER;
     } else {
-      p_out[i] = d->key[hash] + 1;
+      p_out[i] = d->slots[hash].key + 1;
     }
   }
 }
@@ -446,11 +946,11 @@ static inline void vec_match_loop_propagate(int* p_out,
 
     uint32_t hash = dict_hash_with(d, d_needles, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       // TODO: Return `no_match` instead
       p_out[i] = NA_INTEGER;
     } else {
-      p_out[i] = d->key[hash] + 1;
+      p_out[i] = d->slots[hash].key + 1;
     }
   }
 }
@@ -465,6 +965,12 @@ SEXP vctrs_in(SEXP needles, SEXP haystack, SEXP na_equal_,
   struct vctrs_arg needles_arg = vec_as_arg(needles_arg_);
   struct vctrs_arg haystack_arg = vec_as_arg(haystack_arg_);
 
+  SEXP handle = R_NilValue;
+  if (is_dictionary_handle(haystack)) {
+    handle = haystack;
+    haystack = dict_handle_ptype(handle);
+  }
+
   SEXP type = vec_ptype2_params(needles, haystack,
                                 &needles_arg, &haystack_arg,
                                 DF_FALLBACK_quiet,
@@ -477,33 +983,14 @@ SEXP vctrs_in(SEXP needles, SEXP haystack, SEXP na_equal_,
                             S3_FALLBACK_false);
   PROTECT_N(needles, &nprot);
 
-  haystack = vec_cast_params(haystack, type,
-                             &haystack_arg, args_empty,
-                             DF_FALLBACK_quiet,
-                             S3_FALLBACK_false);
-  PROTECT_N(haystack, &nprot);
-
   needles = PROTECT_N(vec_proxy_equal(needles), &nprot);
   needles = PROTECT_N(vec_normalize_encoding(needles), &nprot);
 
-  haystack = PROTECT_N(vec_proxy_equal(haystack), &nprot);
-  haystack = PROTECT_N(vec_normalize_encoding(haystack), &nprot);
-
-  R_len_t n_haystack = vec_size(haystack);
   R_len_t n_needle = vec_size(needles);
 
-  struct dictionary* d = new_dictionary_params(haystack, false, na_equal);
+  struct dictionary* d = dict_prepare_haystack(haystack, handle, type, na_equal, &haystack_arg);
   PROTECT_DICT(d, &nprot);
 
-  // Load dictionary with haystack
-  for (int i = 0; i < n_haystack; ++i) {
-    uint32_t hash = dict_hash_scalar(d, i);
-
-    if (d->key[hash] == DICT_EMPTY) {
-      dict_put(d, hash, i);
-    }
-  }
-
   struct dictionary* d_needles = new_dictionary_params(needles, true, na_equal);
   PROTECT_DICT(d_needles, &nprot);
 
@@ -518,7 +1005,7 @@ SEXP vctrs_in(SEXP needles, SEXP haystack, SEXP na_equal_,
       p_out[i] = NA_LOGICAL;
     } else {
       uint32_t hash = dict_hash_with(d, d_needles, i);
-      p_out[i] = (d->key[hash] != DICT_EMPTY);
+      p_out[i] = (d->slots[hash].key != DICT_EMPTY);
     }
   }
 
@@ -543,7 +1030,7 @@ SEXP vctrs_count(SEXP x) {
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
       p_val[hash] = 0;
     }
@@ -557,11 +1044,11 @@ SEXP vctrs_count(SEXP x) {
   int* p_out_val = INTEGER(out_val);
 
   int i = 0;
-  for (uint32_t hash = 0; hash < d->size; ++hash) {
-    if (d->key[hash] == DICT_EMPTY)
+  for (uint64_t hash = 0; hash < d->size; ++hash) {
+    if (d->slots[hash].key == DICT_EMPTY)
       continue;
 
-    p_out_key[i] = d->key[hash] + 1;
+    p_out_key[i] = d->slots[hash].key + 1;
     p_out_val[i] = p_val[hash];
     i++;
   }
@@ -595,7 +1082,7 @@ SEXP vctrs_duplicated(SEXP x) {
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
       p_val[hash] = 0;
     }
@@ -619,4 +1106,19 @@ SEXP vctrs_duplicated(SEXP x) {
 void vctrs_init_dictionary(SEXP ns) {
   args_needles = new_wrapper_arg(NULL, "needles");
   args_haystack = new_wrapper_arg(NULL, "haystack");
+
+  dict_handle_names = Rf_allocVector(STRSXP, DICT_HANDLE_SIZE);
+  R_PreserveObject(dict_handle_names);
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_haystack, Rf_mkChar("haystack"));
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_ptype, Rf_mkChar("ptype"));
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_proxy, Rf_mkChar("proxy"));
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_key, Rf_mkChar("key"));
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_hash, Rf_mkChar("hash"));
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_used, Rf_mkChar("used"));
+  SET_STRING_ELT(dict_handle_names, DICT_HANDLE_sentinel, Rf_mkChar("sentinel"));
+  MARK_NOT_MUTABLE(dict_handle_names);
+
+  classes_vctrs_dictionary = Rf_mkString("vctrs_dictionary");
+  R_PreserveObject(classes_vctrs_dictionary);
+  MARK_NOT_MUTABLE(classes_vctrs_dictionary);
 }
@@ -9,6 +9,14 @@
 // another vector, provided that they're of the same type (which is ensured
 // at the R-level).
 
+// Slots store the full hash of their key next to it. This way most
+// collisions are rejected while probing without dereferencing the
+// element-indexed `hash` array or the data itself.
+struct dictionary_slot {
+  R_len_t key;
+  uint32_t hash;
+};
+
 struct dictionary {
   SEXP protect;
 
@@ -17,9 +25,11 @@ struct dictionary {
   struct poly_vec* p_poly_vec;
 
   uint32_t* hash;
-  R_len_t* key;
+  struct dictionary_slot* slots;
 
-  uint32_t size;
+  // Number of `slots`. This is a power of 2 of at most 2^32, so
+  // slots fit in a `uint32_t` but the size itself doesn't.
+  uint64_t size;
   uint32_t used;
 };
 
@@ -62,4 +72,40 @@ uint32_t dict_hash_with(struct dictionary* d, struct dictionary* x, R_len_t i);
 
 bool dict_is_missing(struct dictionary* d, R_len_t i);
 
+/**
+ * Dictionary handles
+ *
+ * A handle is a classed list created by `vctrs_new_dictionary()` that
+ * owns the key and hash arrays of a fully loaded dictionary, so that
+ * they persist across `.Call()`s.
+ *
+ * - `is_dictionary_handle()` checks whether `x` is a handle.
+ *
+ * - `dict_from_handle()` creates a read-only dictionary that shares the
+ *   arrays of the handle. Protect it with `PROTECT_DICT()`.
+ */
+bool is_dictionary_handle(SEXP x);
+struct dictionary* dict_from_handle(SEXP handle);
+
+/**
+ * Engine selection
+ *
+ * - `dict_engine()` predicts whether hashing or radix ordering is the
+ *   faster way to find the unique values of the equality proxy `x`.
+ *
+ * - `dict_sort_info()` returns the `vec_order_info()` of `x`, with
+ *   groups of equal values.
+ *
+ * - `dict_sort_key_groups()` maps the first location of each group of
+ *   `info` to the index of that group, and other locations to `-1`.
+ */
+enum dict_engine {
+  DICT_ENGINE_hash,
+  DICT_ENGINE_sort
+};
+
+enum dict_engine dict_engine(SEXP x);
+SEXP dict_sort_info(SEXP x);
+SEXP dict_sort_key_groups(SEXP info, R_len_t n);
+
 void dict_put(struct dictionary* d, uint32_t k, R_len_t i);
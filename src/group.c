@@ -24,7 +24,7 @@ SEXP vctrs_group_id(SEXP x) {
 
   for (int i = 0; i < n; ++i) {
     uint32_t hash = dict_hash_scalar(d, i);
-    R_len_t key = d->key[hash];
+    R_len_t key = d->slots[hash].key;
 
     if (key == DICT_EMPTY) {
       dict_put(d, hash, i);
@@ -97,7 +97,7 @@ SEXP vctrs_group_rle(SEXP x) {
     // Check if we have seen this value before
     uint32_t hash = dict_hash_scalar(d, i);
 
-    if (d->key[hash] == DICT_EMPTY) {
+    if (d->slots[hash].key == DICT_EMPTY) {
       dict_put(d, hash, i);
       p_map[hash] = loc;
       p_g[loc] = d->used;
@@ -139,6 +139,11 @@ static SEXP new_group_rle(SEXP g, SEXP l, R_len_t n) {
 
 // -----------------------------------------------------------------------------
 
+// Returns a list of the first location of each group and the list of
+// locations of each group, in order of first appearance
+static SEXP group_loc_hash(SEXP proxy, R_len_t n);
+static SEXP group_loc_sort(SEXP proxy, R_len_t n);
+
 // [[ include("vctrs.h"); register() ]]
 SEXP vec_group_loc(SEXP x) {
   int nprot = 0;
@@ -148,6 +153,40 @@ SEXP vec_group_loc(SEXP x) {
   SEXP proxy = PROTECT_N(vec_proxy_equal(x), &nprot);
   proxy = PROTECT_N(vec_normalize_encoding(proxy), &nprot);
 
+  SEXP info;
+  if (dict_engine(proxy) == DICT_ENGINE_sort) {
+    info = PROTECT_N(group_loc_sort(proxy, n), &nprot);
+  } else {
+    info = PROTECT_N(group_loc_hash(proxy, n), &nprot);
+  }
+
+  SEXP key_loc = VECTOR_ELT(info, 0);
+  SEXP out_loc = VECTOR_ELT(info, 1);
+  R_len_t n_groups = Rf_length(key_loc);
+
+  SEXP out_key = PROTECT_N(vec_slice(x, key_loc), &nprot);
+
+  // Construct output data frame
+  SEXP out = PROTECT_N(Rf_allocVector(VECSXP, 2), &nprot);
+  SET_VECTOR_ELT(out, 0, out_key);
+  SET_VECTOR_ELT(out, 1, out_loc);
+
+  SEXP names = PROTECT_N(Rf_allocVector(STRSXP, 2), &nprot);
+  SET_STRING_ELT(names, 0, strings_key);
+  SET_STRING_ELT(names, 1, strings_loc);
+
+  Rf_setAttrib(out, R_NamesSymbol, names);
+
+  out = new_data_frame(out, n_groups);
+
+  UNPROTECT(nprot);
+  return out;
+}
+
+static
+SEXP group_loc_hash(SEXP proxy, R_len_t n) {
+  int nprot = 0;
+
   struct dictionary* d = new_dictionary(proxy);
   PROTECT_DICT(d, &nprot);
 
@@ -159,7 +198,7 @@ SEXP vec_group_loc(SEXP x) {
   // Identify groups, this is essentially `vec_group_id()`
   for (int i = 0; i < n; ++i) {
     const uint32_t hash = dict_hash_scalar(d, i);
-    const R_len_t key = d->key[hash];
+    const R_len_t key = d->slots[hash].key;
 
     if (key == DICT_EMPTY) {
       dict_put(d, hash, i);
@@ -219,21 +258,65 @@ SEXP vec_group_loc(SEXP x) {
     ++p_locations[group];
   }
 
-  SEXP out_key = PROTECT_N(vec_slice(x, key_loc), &nprot);
-
-  // Construct output data frame
   SEXP out = PROTECT_N(Rf_allocVector(VECSXP, 2), &nprot);
-  SET_VECTOR_ELT(out, 0, out_key);
+  SET_VECTOR_ELT(out, 0, key_loc);
   SET_VECTOR_ELT(out, 1, out_loc);
 
-  SEXP names = PROTECT_N(Rf_allocVector(STRSXP, 2), &nprot);
-  SET_STRING_ELT(names, 0, strings_key);
-  SET_STRING_ELT(names, 1, strings_loc);
+  UNPROTECT(nprot);
+  return out;
+}
 
-  Rf_setAttrib(out, R_NamesSymbol, names);
+static
+SEXP group_loc_sort(SEXP proxy, R_len_t n) {
+  SEXP info = PROTECT(dict_sort_info(proxy));
+  const int* p_o = INTEGER_RO(VECTOR_ELT(info, 0));
 
-  out = new_data_frame(out, n_groups);
+  SEXP sizes = VECTOR_ELT(info, 1);
+  const int* p_sizes = INTEGER_RO(sizes);
+  const R_len_t n_groups = Rf_length(sizes);
 
-  UNPROTECT(nprot);
+  // Start of each group in the ordering
+  int* p_starts = (int*) R_alloc(n_groups, sizeof(int));
+  int start = 0;
+
+  for (R_len_t i = 0; i < n_groups; ++i) {
+    p_starts[i] = start;
+    start += p_sizes[i];
+  }
+
+  SEXP key_groups = PROTECT(dict_sort_key_groups(info, n));
+  const int* p_key_groups = INTEGER_RO(key_groups);
+
+  SEXP key_loc = PROTECT(Rf_allocVector(INTSXP, n_groups));
+  int* p_key_loc = INTEGER(key_loc);
+
+  SEXP out_loc = PROTECT(Rf_allocVector(VECSXP, n_groups));
+
+  R_len_t g = 0;
+
+  // Walk `x` to emit groups in order of first appearance. The ordering is
+  // stable, so locations within a group are already increasing.
+  for (R_len_t i = 0; i < n; ++i) {
+    const int group = p_key_groups[i];
+
+    if (group < 0) {
+      continue;
+    }
+
+    p_key_loc[g] = i + 1;
+
+    const int size = p_sizes[group];
+    SEXP elt_loc = Rf_allocVector(INTSXP, size);
+    SET_VECTOR_ELT(out_loc, g, elt_loc);
+    memcpy(INTEGER(elt_loc), p_o + p_starts[group], size * sizeof(int));
+
+    ++g;
+  }
+
+  SEXP out = PROTECT(Rf_allocVector(VECSXP, 2));
+  SET_VECTOR_ELT(out, 0, key_loc);
+  SET_VECTOR_ELT(out, 1, out_loc);
+
+  UNPROTECT(5);
   return out;
 }
@@ -4,6 +4,7 @@
 #include "hash.h"
 #include "utils.h"
 #include "dim.h"
+#include "parallel.h"
 
 // boost::hash_combine from https://stackoverflow.com/questions/35985960
 static inline uint32_t hash_combine(uint32_t x, uint32_t y) {
@@ -284,40 +285,51 @@ void hash_fill(uint32_t* p, R_len_t size, SEXP x, bool na_equal) {
   stop_unimplemented_vctrs_type("hash_fill", vec_proxy_typeof(x));
 }
 
-#define HASH_FILL(CTYPE, CONST_DEREF, HASHER)   \
-  const CTYPE* xp = CONST_DEREF(x);             \
-                                                \
-  for (R_len_t i = 0; i < size; ++i, ++xp) {    \
-    p[i] = hash_combine(p[i], HASHER(xp));      \
+// Below this size, the cost of spawning threads exceeds the cost of
+// hashing. Elements are hashed independently of each other, so the
+// output is the same whatever the number of threads.
+#define HASH_FILL_PARALLEL_THRESHOLD 100000
+
+#define HASH_FILL(CTYPE, CONST_DEREF, HASHER)                           \
+  const CTYPE* xp = CONST_DEREF(x);                                     \
+  const int n_threads = vec_n_threads(size, HASH_FILL_PARALLEL_THRESHOLD); \
+                                                                        \
+  VCTRS_OMP_PARALLEL_FOR(n_threads)                                     \
+  for (R_len_t i = 0; i < size; ++i) {                                  \
+    p[i] = hash_combine(p[i], HASHER(xp + i));                          \
   }
 
 #define HASH_FILL_NA_PROPAGATE(CTYPE, CONST_DEREF, HASHER, NA_VALUE)    \
   const CTYPE* xp = CONST_DEREF(x);                                     \
+  const int n_threads = vec_n_threads(size, HASH_FILL_PARALLEL_THRESHOLD); \
                                                                         \
-  for (R_len_t i = 0; i < size; ++i, ++xp) {                            \
+  VCTRS_OMP_PARALLEL_FOR(n_threads)                                     \
+  for (R_len_t i = 0; i < size; ++i) {                                  \
     uint32_t h = p[i];                                                  \
     if (h == HASH_MISSING) {                                            \
       continue;                                                         \
     }                                                                   \
-    if (*xp == NA_VALUE) {                                              \
+    if (xp[i] == NA_VALUE) {                                            \
       p[i] = HASH_MISSING;                                              \
     } else {                                                            \
-      p[i] = hash_combine(h, HASHER(xp));                               \
+      p[i] = hash_combine(h, HASHER(xp + i));                           \
     }                                                                   \
   }
 
 #define HASH_FILL_NA_PROPAGATE_CMP(CTYPE, CONST_DEREF, HASHER, NA_CMP)  \
   const CTYPE* xp = CONST_DEREF(x);                                     \
+  const int n_threads = vec_n_threads(size, HASH_FILL_PARALLEL_THRESHOLD); \
                                                                         \
-  for (R_len_t i = 0; i < size; ++i, ++xp) {                            \
+  VCTRS_OMP_PARALLEL_FOR(n_threads)                                     \
+  for (R_len_t i = 0; i < size; ++i) {                                  \
     uint32_t h = p[i];                                                  \
     if (h == HASH_MISSING) {                                            \
       continue;                                                         \
     }                                                                   \
-    if (NA_CMP(*xp)) {                                                  \
+    if (NA_CMP(xp[i])) {                                                \
       p[i] = HASH_MISSING;                                              \
     } else {                                                            \
-      p[i] = hash_combine(h, HASHER(xp));                               \
+      p[i] = hash_combine(h, HASHER(xp + i));                           \
     }                                                                   \
   }
 
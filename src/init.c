@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <R_ext/Rdynload.h>
 #include "altrep-rle.h"
+#include "altrep-view.h"
 #include "vctrs.h"
 
 // Compile with `-fvisibility=hidden -DHAVE_VISIBILITY_ATTRIBUTE` if you link to this library
@@ -33,6 +34,7 @@ extern SEXP vctrs_equal_na(SEXP);
 extern SEXP vctrs_compare(SEXP, SEXP, SEXP);
 extern SEXP vctrs_match(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_in(SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP vctrs_new_dictionary(SEXP, SEXP);
 extern SEXP vctrs_duplicated_any(SEXP);
 extern SEXP vctrs_size(SEXP);
 extern SEXP vctrs_list_sizes(SEXP);
@@ -51,6 +53,7 @@ extern SEXP vctrs_init(SEXP, SEXP);
 extern SEXP vctrs_chop(SEXP, SEXP);
 extern SEXP vctrs_unchop(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_chop_seq(SEXP, SEXP, SEXP, SEXP);
+extern SEXP vctrs_chop_order(SEXP, SEXP, SEXP);
 extern SEXP vec_slice_seq(SEXP, SEXP, SEXP, SEXP);
 extern SEXP vec_slice_rep(SEXP, SEXP, SEXP);
 extern SEXP vctrs_restore(SEXP, SEXP, SEXP);
@@ -79,6 +82,7 @@ extern SEXP vctrs_bare_df_restore(SEXP, SEXP, SEXP);
 extern SEXP vctrs_recycle(SEXP, SEXP, SEXP);
 extern SEXP vctrs_assign(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_assign_seq(SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP vctrs_assign_many(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_set_attributes(SEXP, SEXP);
 extern SEXP vctrs_as_df_row(SEXP, SEXP);
 extern SEXP vctrs_outer_names(SEXP, SEXP, SEXP);
@@ -130,6 +134,7 @@ extern SEXP vctrs_normalize_encoding(SEXP);
 extern SEXP vctrs_order(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_order_locs(SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_order_info(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP vctrs_order_topk(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP vctrs_unrep(SEXP);
 extern SEXP vctrs_fill_missing(SEXP, SEXP, SEXP);
 extern SEXP vctrs_chr_paste_prefix(SEXP, SEXP, SEXP);
@@ -160,6 +165,7 @@ SEXP vctrs_init_library(SEXP);
 // Defined in altrep-rle.h
 extern SEXP altrep_rle_Make(SEXP);
 void vctrs_init_altrep_rle(DllInfo* dll);
+void vctrs_init_altrep_view(DllInfo* dll);
 
 static const R_CallMethodDef CallEntries[] = {
   {"vctrs_list_get",                   (DL_FUNC) &vctrs_list_get, 2},
@@ -191,6 +197,7 @@ static const R_CallMethodDef CallEntries[] = {
   {"vctrs_compare",                    (DL_FUNC) &vctrs_compare, 3},
   {"vctrs_match",                      (DL_FUNC) &vctrs_match, 5},
   {"vctrs_in",                         (DL_FUNC) &vctrs_in, 5},
+  {"vctrs_new_dictionary",             (DL_FUNC) &vctrs_new_dictionary, 2},
   {"vctrs_typeof",                     (DL_FUNC) &vctrs_typeof, 2},
   {"vctrs_init_library",               (DL_FUNC) &vctrs_init_library, 1},
   {"vctrs_is_vector",                  (DL_FUNC) &vctrs_is_vector, 1},
@@ -204,6 +211,7 @@ static const R_CallMethodDef CallEntries[] = {
   {"vctrs_chop",                       (DL_FUNC) &vctrs_chop, 2},
   {"vctrs_unchop",                     (DL_FUNC) &vctrs_unchop, 5},
   {"vctrs_chop_seq",                   (DL_FUNC) &vctrs_chop_seq, 4},
+  {"vctrs_chop_order",                 (DL_FUNC) &vctrs_chop_order, 3},
   {"vctrs_slice_seq",                  (DL_FUNC) &vec_slice_seq, 4},
   {"vctrs_slice_rep",                  (DL_FUNC) &vec_slice_rep, 3},
   {"vctrs_restore",                    (DL_FUNC) &vctrs_restore, 3},
@@ -232,6 +240,7 @@ static const R_CallMethodDef CallEntries[] = {
   {"vctrs_recycle",                    (DL_FUNC) &vctrs_recycle, 3},
   {"vctrs_assign",                     (DL_FUNC) &vctrs_assign, 5},
   {"vctrs_assign_seq",                 (DL_FUNC) &vctrs_assign_seq, 5},
+  {"vctrs_assign_many",                (DL_FUNC) &vctrs_assign_many, 5},
   {"vctrs_set_attributes",             (DL_FUNC) &vctrs_set_attributes, 2},
   {"vctrs_as_df_row",                  (DL_FUNC) &vctrs_as_df_row, 2},
   {"vctrs_outer_names",                (DL_FUNC) &vctrs_outer_names, 3},
@@ -284,6 +293,7 @@ static const R_CallMethodDef CallEntries[] = {
   {"vctrs_order",                      (DL_FUNC) &vctrs_order, 5},
   {"vctrs_order_locs",                 (DL_FUNC) &vctrs_order_locs, 5},
   {"vctrs_order_info",                 (DL_FUNC) &vctrs_order_info, 6},
+  {"vctrs_order_topk",                 (DL_FUNC) &vctrs_order_topk, 6},
   {"vctrs_unrep",                      (DL_FUNC) &vctrs_unrep, 1},
   {"vctrs_fill_missing",               (DL_FUNC) &vctrs_fill_missing, 3},
   {"vctrs_chr_paste_prefix",           (DL_FUNC) &vctrs_chr_paste_prefix, 3},
@@ -341,6 +351,7 @@ export void R_init_vctrs(DllInfo *dll)
 
     // Altrep classes
     vctrs_init_altrep_rle(dll);
+    vctrs_init_altrep_view(dll);
 }
 
 
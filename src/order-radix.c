@@ -21,6 +21,7 @@
 #include "order-truelength.h"
 #include "order-sortedness.h"
 #include "order-transform.h"
+#include "parallel.h"
 
 // -----------------------------------------------------------------------------
 
@@ -176,6 +177,14 @@
  */
 #define ORDER_INSERTION_BOUNDARY 128
 
+/*
+ * Size of `x` above which the radix ordering of integers and doubles, and the
+ * ordering of data frame column chunks can run in parallel, see
+ * `int_order_radix_parallel()` and `df_order_chunks_parallel()`. The number
+ * of threads is controlled by the `vctrs.num_threads` global option.
+ */
+#define ORDER_RADIX_PARALLEL_THRESHOLD 100000
+
 /*
  * Adjustments for translating current `pass` into the current `radix` byte
  * that we need to shift to.
@@ -336,6 +345,8 @@ static SEXP parse_direction(SEXP direction);
 static SEXP vec_order_expand_args(SEXP x, SEXP decreasing, SEXP na_largest);
 static SEXP vec_order_compute_na_last(SEXP na_largest, SEXP decreasing);
 
+static bool chr_order_use_hash(r_ssize size);
+
 static void vec_order_switch(SEXP x,
                              SEXP decreasing,
                              SEXP na_last,
@@ -435,6 +446,7 @@ SEXP vec_order_info_impl(SEXP x,
   // when not ordering character vectors
   struct truelength_info* p_truelength_info = new_truelength_info(size);
   PROTECT_TRUELENGTH_INFO(p_truelength_info, &n_prot);
+  p_truelength_info->use_hash = chr_ordered && chr_order_use_hash(size);
 
   struct order* p_order = new_order(size);
   PROTECT_ORDER(p_order, &n_prot);
@@ -472,6 +484,410 @@ SEXP vec_order_info_impl(SEXP x,
   return out;
 }
 
+/*
+ * Sorted strings are marked in a private hash table rather than in their
+ * TRUELENGTH when ordering may use multiple threads, so that data frame
+ * chunks with character columns can be ordered in parallel. The internal
+ * `vctrs:::chr_order_hash` option forces either approach, which is useful
+ * for testing and benchmarking.
+ */
+static
+bool chr_order_use_hash(r_ssize size) {
+  SEXP opt = r_peek_option("vctrs:::chr_order_hash");
+
+  if (opt != R_NilValue) {
+    return r_is_true(opt);
+  }
+
+  return vec_n_threads(size, ORDER_RADIX_PARALLEL_THRESHOLD) > 1;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * `vec_order_topk()` returns the first `k` locations of `vec_order(x)` without
+ * ordering all of `x`.
+ *
+ * When `x` is an integer, logical, or double vector, or a data frame whose
+ * first column is one, that key is mapped to unsigned integers exactly like
+ * the radix ordering does with `int_adjust()` and `dbl_adjust()`.
+ *
+ * - For tiny `k`, a bounded max-heap of locations keeps the `k` smallest keys
+ *   in a single pass. Ties are broken by location, so the result is stable.
+ *
+ * - Otherwise, the `k`-th smallest key is selected byte by byte, only
+ *   descending into the bucket that contains it. Every location with a
+ *   smaller key is a candidate, along with the first tied locations needed to
+ *   make up `k` (or all tied locations for a data frame, since later columns
+ *   break those ties). The candidates are then fully ordered with the regular
+ *   engine and mapped back to locations in `x`.
+ *
+ * Other inputs, and `k` larger than half the size of `x`, fall back to a full
+ * ordering which is then truncated.
+ */
+
+/*
+ * Largest `k` that uses the heap rather than the bucket selection.
+ * Sifting through a heap costs `log2(k)` comparisons per replaced element,
+ * which stays cheaper than the selection passes while `k` is small.
+ */
+#define ORDER_TOPK_HEAP_BOUNDARY 64
+
+static SEXP vec_order_topk(SEXP x,
+                           r_ssize k,
+                           SEXP direction,
+                           SEXP na_value,
+                           bool nan_distinct,
+                           SEXP chr_transform);
+
+// [[ register() ]]
+SEXP vctrs_order_topk(SEXP x,
+                      SEXP k,
+                      SEXP direction,
+                      SEXP na_value,
+                      SEXP nan_distinct,
+                      SEXP chr_transform) {
+  R_len_t c_k = size_validate(k, "k");
+
+  if (c_k < 0) {
+    Rf_errorcall(R_NilValue, "`k` must be a positive number or zero.");
+  }
+
+  bool c_nan_distinct = parse_nan_distinct(nan_distinct);
+  return vec_order_topk(x, c_k, direction, na_value, c_nan_distinct, chr_transform);
+}
+
+static void int_adjust(const bool decreasing,
+                       const bool na_last,
+                       const r_ssize size,
+                       void* p_x);
+
+static void dbl_adjust(const bool decreasing,
+                       const bool na_last,
+                       const bool nan_distinct,
+                       const r_ssize size,
+                       void* p_x);
+
+static bool topk_fill_keys(SEXP key,
+                           bool decreasing,
+                           bool na_last,
+                           bool nan_distinct,
+                           r_ssize size,
+                           uint64_t* p_keys);
+
+static void topk_heap(const uint64_t* p_keys, r_ssize size, r_ssize k, int* p_out);
+
+static uint64_t topk_select(const uint64_t* p_keys,
+                            r_ssize size,
+                            r_ssize k,
+                            uint64_t* p_aux);
+
+static SEXP vec_order_truncate(SEXP x,
+                               r_ssize k,
+                               SEXP direction,
+                               SEXP na_value,
+                               bool nan_distinct,
+                               SEXP chr_transform);
+
+static
+SEXP vec_order_topk(SEXP x,
+                    r_ssize k,
+                    SEXP direction,
+                    SEXP na_value,
+                    bool nan_distinct,
+                    SEXP chr_transform) {
+  int n_prot = 0;
+
+  SEXP decreasing = PROTECT_N(parse_direction(direction), &n_prot);
+  SEXP na_largest = PROTECT_N(parse_na_value(na_value), &n_prot);
+
+  // Call on `x` before potentially flattening cols with `vec_proxy_order()`
+  SEXP args = PROTECT_N(vec_order_expand_args(x, decreasing, na_largest), &n_prot);
+  R_len_t arg_size = vec_size_common(args, 0);
+  args = PROTECT_N(vec_recycle_common(args, arg_size), &n_prot);
+
+  decreasing = VECTOR_ELT(args, 0);
+  na_largest = VECTOR_ELT(args, 1);
+
+  SEXP na_last = PROTECT_N(vec_order_compute_na_last(na_largest, decreasing), &n_prot);
+
+  SEXP proxy = PROTECT_N(vec_proxy_order(x), &n_prot);
+  const r_ssize size = vec_size(proxy);
+
+  if (k == 0) {
+    UNPROTECT(n_prot);
+    return vctrs_shared_empty_int;
+  }
+
+  const bool df = is_data_frame(proxy);
+
+  // A full ordering is just as fast when most of `x` is requested
+  if (k > size / 2 || (df && r_length(proxy) == 0)) {
+    UNPROTECT(n_prot);
+    return vec_order_truncate(x, k, direction, na_value, nan_distinct, chr_transform);
+  }
+
+  SEXP key = df ? VECTOR_ELT(proxy, 0) : proxy;
+
+  SEXP keys = PROTECT_N(r_alloc_raw(size * sizeof(uint64_t)), &n_prot);
+  uint64_t* p_keys = (uint64_t*) RAW(keys);
+
+  const bool filled = topk_fill_keys(
+    key,
+    LOGICAL_RO(decreasing)[0],
+    LOGICAL_RO(na_last)[0],
+    nan_distinct,
+    size,
+    p_keys
+  );
+
+  if (!filled) {
+    UNPROTECT(n_prot);
+    return vec_order_truncate(x, k, direction, na_value, nan_distinct, chr_transform);
+  }
+
+  if (!df && k <= ORDER_TOPK_HEAP_BOUNDARY) {
+    SEXP out = PROTECT_N(r_alloc_integer(k), &n_prot);
+    topk_heap(p_keys, size, k, INTEGER(out));
+    UNPROTECT(n_prot);
+    return out;
+  }
+
+  SEXP aux = PROTECT_N(r_alloc_raw(size * sizeof(uint64_t)), &n_prot);
+  uint64_t* p_aux = (uint64_t*) RAW(aux);
+
+  const uint64_t threshold = topk_select(p_keys, size, k, p_aux);
+
+  r_ssize n_less = 0;
+  r_ssize n_ties = 0;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const uint64_t elt = p_keys[i];
+    n_less += elt < threshold;
+    n_ties += elt == threshold;
+  }
+
+  // Only the first ties are needed for vectors, since the ordering is stable
+  if (!df) {
+    n_ties = k - n_less;
+  }
+
+  SEXP loc = PROTECT_N(r_alloc_integer(n_less + n_ties), &n_prot);
+  int* p_loc = INTEGER(loc);
+
+  r_ssize j = 0;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const uint64_t elt = p_keys[i];
+
+    if (elt < threshold) {
+      p_loc[j] = i + 1;
+      ++j;
+    } else if (elt == threshold && n_ties > 0) {
+      p_loc[j] = i + 1;
+      ++j;
+      --n_ties;
+    }
+  }
+
+  SEXP candidates = PROTECT_N(vec_slice(x, loc), &n_prot);
+  SEXP o = PROTECT_N(vec_order(candidates, direction, na_value, nan_distinct, chr_transform), &n_prot);
+  const int* p_o = INTEGER_RO(o);
+
+  SEXP out = PROTECT_N(r_alloc_integer(k), &n_prot);
+  int* p_out = INTEGER(out);
+
+  for (r_ssize i = 0; i < k; ++i) {
+    p_out[i] = p_loc[p_o[i] - 1];
+  }
+
+  UNPROTECT(n_prot);
+  return out;
+}
+
+static
+SEXP vec_order_truncate(SEXP x,
+                        r_ssize k,
+                        SEXP direction,
+                        SEXP na_value,
+                        bool nan_distinct,
+                        SEXP chr_transform) {
+  SEXP o = PROTECT(vec_order(x, direction, na_value, nan_distinct, chr_transform));
+
+  if (k >= r_length(o)) {
+    UNPROTECT(1);
+    return o;
+  }
+
+  SEXP out = PROTECT(r_alloc_integer(k));
+  memcpy(INTEGER(out), INTEGER_RO(o), k * sizeof(int));
+
+  UNPROTECT(2);
+  return out;
+}
+
+/*
+ * Maps `key` to the same unsigned keys used by the radix ordering, widened
+ * to 64 bits. Returns `false` if `key` isn't a type that can be mapped.
+ */
+static
+bool topk_fill_keys(SEXP key,
+                    bool decreasing,
+                    bool na_last,
+                    bool nan_distinct,
+                    r_ssize size,
+                    uint64_t* p_keys) {
+  if (r_dim(key) != R_NilValue) {
+    return false;
+  }
+
+  switch (TYPEOF(key)) {
+  case LGLSXP:
+  case INTSXP: {
+    // Adjust in the front half of `p_keys`, then widen from the back so
+    // that no 32-bit key is overwritten before it is read
+    uint32_t* p_keys_u32 = (uint32_t*) p_keys;
+    memcpy(p_keys_u32, TYPEOF(key) == LGLSXP ? LOGICAL_RO(key) : INTEGER_RO(key), size * sizeof(int));
+    int_adjust(decreasing, na_last, size, p_keys_u32);
+
+    for (r_ssize i = size - 1; i >= 0; --i) {
+      p_keys[i] = (uint64_t) p_keys_u32[i];
+    }
+
+    return true;
+  }
+  case REALSXP: {
+    memcpy(p_keys, REAL_RO(key), size * sizeof(double));
+    dbl_adjust(decreasing, na_last, nan_distinct, size, p_keys);
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+// Is location `i` ordered before location `j`? Ties are broken by location.
+static inline
+bool topk_before(const uint64_t* p_keys, int i, int j) {
+  const uint64_t x_i = p_keys[i];
+  const uint64_t x_j = p_keys[j];
+  return x_i < x_j || (x_i == x_j && i < j);
+}
+
+static inline
+void topk_sift_down(const uint64_t* p_keys, int* p_heap, r_ssize size, r_ssize i) {
+  while (true) {
+    r_ssize largest = i;
+    const r_ssize left = 2 * i + 1;
+    const r_ssize right = left + 1;
+
+    if (left < size && topk_before(p_keys, p_heap[largest], p_heap[left])) {
+      largest = left;
+    }
+    if (right < size && topk_before(p_keys, p_heap[largest], p_heap[right])) {
+      largest = right;
+    }
+    if (largest == i) {
+      return;
+    }
+
+    const int tmp = p_heap[i];
+    p_heap[i] = p_heap[largest];
+    p_heap[largest] = tmp;
+    i = largest;
+  }
+}
+
+/*
+ * Keeps the `k` smallest locations in a max-heap stored in `p_out`, then
+ * heap sorts them in place and converts them to 1-based locations.
+ */
+static
+void topk_heap(const uint64_t* p_keys, r_ssize size, r_ssize k, int* p_out) {
+  for (r_ssize i = 0; i < k; ++i) {
+    p_out[i] = i;
+  }
+  for (r_ssize i = k / 2 - 1; i >= 0; --i) {
+    topk_sift_down(p_keys, p_out, k, i);
+  }
+
+  for (r_ssize i = k; i < size; ++i) {
+    // Later locations only win on a strictly smaller key
+    if (p_keys[i] < p_keys[p_out[0]]) {
+      p_out[0] = i;
+      topk_sift_down(p_keys, p_out, k, 0);
+    }
+  }
+
+  for (r_ssize i = k - 1; i > 0; --i) {
+    const int tmp = p_out[0];
+    p_out[0] = p_out[i];
+    p_out[i] = tmp;
+    topk_sift_down(p_keys, p_out, i, 0);
+  }
+
+  for (r_ssize i = 0; i < k; ++i) {
+    ++p_out[i];
+  }
+}
+
+/*
+ * Returns the `k`-th smallest key. Each pass counts one byte of the
+ * remaining candidates, starting from the most significant one, and keeps
+ * only the candidates in the bucket holding the `k`-th key. Passes where all
+ * candidates share the same byte don't need to copy anything.
+ */
+static
+uint64_t topk_select(const uint64_t* p_keys,
+                     r_ssize size,
+                     r_ssize k,
+                     uint64_t* p_aux) {
+  const uint64_t* p_src = p_keys;
+  r_ssize n = size;
+
+  r_ssize counts[UINT8_MAX_SIZE];
+
+  for (int shift = 56; shift >= 0 && n > 1; shift -= 8) {
+    memset(counts, 0, sizeof(counts));
+
+    for (r_ssize i = 0; i < n; ++i) {
+      ++counts[(p_src[i] >> shift) & UINT8_MAX];
+    }
+
+    uint16_t bucket = 0;
+    r_ssize cumulative = 0;
+
+    while (cumulative + counts[bucket] < k) {
+      cumulative += counts[bucket];
+      ++bucket;
+    }
+
+    k -= cumulative;
+
+    if (counts[bucket] == n) {
+      continue;
+    }
+
+    r_ssize j = 0;
+
+    for (r_ssize i = 0; i < n; ++i) {
+      const uint64_t elt = p_src[i];
+
+      if (((elt >> shift) & UINT8_MAX) == bucket) {
+        p_aux[j] = elt;
+        ++j;
+      }
+    }
+
+    p_src = p_aux;
+    n = j;
+  }
+
+  return p_src[0];
+}
+
+#undef ORDER_TOPK_HEAP_BOUNDARY
+
 // -----------------------------------------------------------------------------
 
 static void df_order(SEXP x,
@@ -801,6 +1217,7 @@ static void int_order_chunk_impl(bool decreasing,
                                  struct lazy_raw* p_lazy_o_aux,
                                  struct lazy_raw* p_lazy_bytes,
                                  struct lazy_raw* p_lazy_counts,
+                                 r_ssize* p_counting_counts,
                                  struct group_infos* p_group_infos);
 
 /*
@@ -827,6 +1244,7 @@ void int_order_chunk(bool decreasing,
                      struct lazy_raw* p_lazy_o_aux,
                      struct lazy_raw* p_lazy_bytes,
                      struct lazy_raw* p_lazy_counts,
+                     r_ssize* p_counting_counts,
                      struct group_infos* p_group_infos) {
   void* p_x_chunk = p_lazy_x_chunk->p_data;
 
@@ -853,6 +1271,7 @@ void int_order_chunk(bool decreasing,
     p_lazy_o_aux,
     p_lazy_bytes,
     p_lazy_counts,
+    p_counting_counts,
     p_group_infos
   );
 }
@@ -900,6 +1319,12 @@ void int_order(SEXP x,
     return;
   }
 
+  // Handle a few presorted runs appended together by merging them
+  if (int_order_runs(p_x, size, decreasing, na_last, p_order->p_data, p_lazy_o_aux, p_group_infos)) {
+    p_order->initialized = true;
+    return;
+  }
+
   int_order_impl(
     p_x,
     decreasing,
@@ -935,8 +1360,20 @@ static void int_order_counting(const int* p_x,
                                bool na_last,
                                int* p_o,
                                int* p_o_aux,
+                               r_ssize* p_counts,
                                struct group_infos* p_group_infos);
 
+/*
+ * Counts of `int_order_counting()` when ordering serially
+ * - Only allocate this once (counts are reset to 0 after each use)
+ * - Allocating as static allows us to allocate an array this large
+ * - `+ 1` to ensure there is room for the extra `NA` bucket
+ *
+ * Data frame chunks ordered in parallel use one counts buffer per thread
+ * instead, see `df_order_chunks_parallel()`.
+ */
+static r_ssize int_order_counting_counts[INT_ORDER_COUNTING_RANGE_BOUNDARY + 1] = { 0 };
+
 static void int_order_insertion(const r_ssize size,
                                 uint32_t* p_x,
                                 int* p_o,
@@ -965,6 +1402,7 @@ void int_order_chunk_impl(bool decreasing,
                           struct lazy_raw* p_lazy_o_aux,
                           struct lazy_raw* p_lazy_bytes,
                           struct lazy_raw* p_lazy_counts,
+                          r_ssize* p_counting_counts,
                           struct group_infos* p_group_infos) {
   if (size <= ORDER_INSERTION_BOUNDARY) {
     int_adjust(decreasing, na_last, size, p_x);
@@ -997,6 +1435,7 @@ void int_order_chunk_impl(bool decreasing,
       na_last,
       p_o,
       p_o_aux,
+      p_counting_counts,
       p_group_infos
     );
 
@@ -1092,6 +1531,7 @@ void int_order_impl(const int* p_x,
       na_last,
       p_o,
       p_o_aux,
+      int_order_counting_counts,
       p_group_infos
     );
 
@@ -1285,6 +1725,9 @@ void int_compute_range(const int* p_x,
  * doesn't spread out values as much when looking at individual radixes.
  *
  * Counting sort does not modify `p_x` in any way.
+ *
+ * `p_counts` must hold `range + 1` counts set to 0. They are reset to 0
+ * before returning.
  */
 static
 void int_order_counting(const int* p_x,
@@ -1296,12 +1739,8 @@ void int_order_counting(const int* p_x,
                         bool na_last,
                         int* p_o,
                         int* p_o_aux,
+                        r_ssize* p_counts,
                         struct group_infos* p_group_infos) {
-  // - Only allocate this once (counts are reset to 0 at end)
-  // - Allocating as static allows us to allocate an array this large
-  // - `+ 1` to ensure there is room for the extra `NA` bucket
-  static r_ssize p_counts[INT_ORDER_COUNTING_RANGE_BOUNDARY + 1] = { 0 };
-
   // `NA` values get counted in the last used bucket
   uint32_t na_bucket = range;
   r_ssize na_count = 0;
@@ -1474,6 +1913,17 @@ void int_order_insertion(const r_ssize size,
 
 // -----------------------------------------------------------------------------
 
+static void int_order_radix_parallel(const r_ssize size,
+                                     const uint8_t pass,
+                                     uint32_t* p_x,
+                                     int* p_o,
+                                     uint32_t* p_x_aux,
+                                     int* p_o_aux,
+                                     uint8_t* p_bytes,
+                                     bool* p_skips,
+                                     const int n_threads,
+                                     struct group_infos* p_group_infos);
+
 static uint8_t int_compute_skips(const uint32_t* p_x, r_ssize size, bool* p_skips);
 
 static void int_order_radix_recurse(const r_ssize size,
@@ -1515,6 +1965,26 @@ void int_order_radix(const r_ssize size,
     return;
   }
 
+  if (p_group_infos->ignore_groups) {
+    const int n_threads = vec_n_threads(size, ORDER_RADIX_PARALLEL_THRESHOLD);
+
+    if (n_threads > 1) {
+      int_order_radix_parallel(
+        size,
+        pass,
+        p_x,
+        p_o,
+        p_x_aux,
+        p_o_aux,
+        p_bytes,
+        p_skips,
+        n_threads,
+        p_group_infos
+      );
+      return;
+    }
+  }
+
   int_order_radix_recurse(
     size,
     pass,
@@ -1672,22 +2142,153 @@ void int_order_radix_recurse(const r_ssize size,
       continue;
     }
 
-    // Order next byte of this subgroup
+    // Order next byte of this subgroup
+    int_order_radix_recurse(
+      group_size,
+      next_pass,
+      p_x,
+      p_o,
+      p_x_aux,
+      p_o_aux,
+      p_bytes,
+      p_counts_next_pass,
+      p_skips,
+      p_group_infos
+    );
+
+    p_x += group_size;
+    p_o += group_size;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Parallel version of the first pass of `int_order_radix_recurse()`
+ *
+ * After the first pass, the 256 radix groups are independent of each other,
+ * so they are ordered concurrently with the serial recursion. The histogram
+ * and placement of the first pass are also split over contiguous chunks of
+ * `p_x`, one per thread. Within a radix group, elements of earlier chunks
+ * are placed first, which keeps the ordering stable.
+ *
+ * Group sizes are pushed from the serial recursion, so this is only used
+ * when groups are ignored.
+ */
+static
+void int_order_radix_parallel(const r_ssize size,
+                              const uint8_t pass,
+                              uint32_t* p_x,
+                              int* p_o,
+                              uint32_t* p_x_aux,
+                              int* p_o_aux,
+                              uint8_t* p_bytes,
+                              bool* p_skips,
+                              const int n_threads,
+                              struct group_infos* p_group_infos) {
+  uint8_t next_pass = pass + 1;
+
+  while (next_pass < INT_MAX_RADIX_PASS && p_skips[next_pass]) {
+    ++next_pass;
+  }
+
+  const uint8_t radix = PASS_TO_RADIX(pass, INT_MAX_RADIX_PASS);
+  const uint8_t shift = radix * 8;
+
+  // One histogram per thread for the first pass, then one full set of
+  // `counts` per thread for the recursion on the radix groups
+  const r_ssize n_counts_recurse = UINT8_MAX_SIZE * INT_MAX_RADIX_PASS;
+
+  r_ssize* p_counts = (r_ssize*) R_alloc(n_threads * UINT8_MAX_SIZE, sizeof(r_ssize));
+  memset(p_counts, 0, n_threads * UINT8_MAX_SIZE * sizeof(r_ssize));
+
+  r_ssize* p_counts_recurse = (r_ssize*) R_alloc(n_threads * n_counts_recurse, sizeof(r_ssize));
+  memset(p_counts_recurse, 0, n_threads * n_counts_recurse * sizeof(r_ssize));
+
+  const r_ssize chunk_size = (size + n_threads - 1) / n_threads;
+
+  // Histogram for this pass
+  VCTRS_OMP_PARALLEL_FOR(n_threads)
+  for (int t = 0; t < n_threads; ++t) {
+    r_ssize* p_chunk_counts = p_counts + t * UINT8_MAX_SIZE;
+
+    const r_ssize start = t * chunk_size;
+    const r_ssize end = (start + chunk_size < size) ? start + chunk_size : size;
+
+    for (r_ssize i = start; i < end; ++i) {
+      const uint8_t byte = int_extract_uint32_byte(p_x[i], shift);
+      p_bytes[i] = byte;
+      ++p_chunk_counts[byte];
+    }
+  }
+
+  // Accumulate counts into starting locations for each chunk of each radix
+  // group. `p_starts` records the boundaries of the radix groups.
+  r_ssize p_starts[UINT8_MAX_SIZE + 1];
+  r_ssize cumulative = 0;
+
+  for (uint16_t i = 0; i < UINT8_MAX_SIZE; ++i) {
+    p_starts[i] = cumulative;
+
+    for (int t = 0; t < n_threads; ++t) {
+      r_ssize* p_count = p_counts + t * UINT8_MAX_SIZE + i;
+      const r_ssize count = *p_count;
+      *p_count = cumulative;
+      cumulative += count;
+    }
+  }
+
+  p_starts[UINT8_MAX_SIZE] = size;
+
+  // Place into auxiliary arrays in the correct order
+  VCTRS_OMP_PARALLEL_FOR(n_threads)
+  for (int t = 0; t < n_threads; ++t) {
+    r_ssize* p_chunk_counts = p_counts + t * UINT8_MAX_SIZE;
+
+    const r_ssize start = t * chunk_size;
+    const r_ssize end = (start + chunk_size < size) ? start + chunk_size : size;
+
+    for (r_ssize i = start; i < end; ++i) {
+      const r_ssize loc = p_chunk_counts[p_bytes[i]]++;
+      p_o_aux[loc] = p_o[i];
+      p_x_aux[loc] = p_x[i];
+    }
+  }
+
+  // Copy back over
+  memcpy(p_o, p_o_aux, size * sizeof(*p_o_aux));
+  memcpy(p_x, p_x_aux, size * sizeof(*p_x_aux));
+
+  // Nothing left to compare in any radix group
+  if (next_pass == INT_MAX_RADIX_PASS) {
+    return;
+  }
+
+  // The size of radix groups can be very uneven, so they are handed out
+  // to threads dynamically
+  VCTRS_OMP_PARALLEL_FOR_DYNAMIC(n_threads)
+  for (int i = 0; i < UINT8_MAX_SIZE; ++i) {
+    const r_ssize start = p_starts[i];
+    const r_ssize group_size = p_starts[i + 1] - start;
+
+    if (group_size <= 1) {
+      continue;
+    }
+
+    r_ssize* p_thread_counts = p_counts_recurse + vec_thread_num() * n_counts_recurse;
+
     int_order_radix_recurse(
       group_size,
       next_pass,
-      p_x,
-      p_o,
-      p_x_aux,
-      p_o_aux,
-      p_bytes,
-      p_counts_next_pass,
+      p_x + start,
+      p_o + start,
+      p_x_aux + start,
+      p_o_aux + start,
+      p_bytes + start,
+      p_thread_counts + next_pass * UINT8_MAX_SIZE,
       p_skips,
       p_group_infos
     );
-
-    p_x += group_size;
-    p_o += group_size;
   }
 }
 
@@ -1774,6 +2375,7 @@ void lgl_order_chunk(bool decreasing,
                      struct lazy_raw* p_lazy_o_aux,
                      struct lazy_raw* p_lazy_bytes,
                      struct lazy_raw* p_lazy_counts,
+                     r_ssize* p_counting_counts,
                      struct group_infos* p_group_infos) {
   int_order_chunk(
     decreasing,
@@ -1785,6 +2387,7 @@ void lgl_order_chunk(bool decreasing,
     p_lazy_o_aux,
     p_lazy_bytes,
     p_lazy_counts,
+    p_counting_counts,
     p_group_infos
   );
 }
@@ -2048,6 +2651,12 @@ void dbl_order_impl(const double* p_x,
     return;
   }
 
+  // Handle a few presorted runs appended together by merging them
+  if (dbl_order_runs(p_x, size, decreasing, na_last, nan_distinct, p_order->p_data, p_lazy_o_aux, p_group_infos)) {
+    p_order->initialized = true;
+    return;
+  }
+
   int* p_o = init_order(p_order);
 
   void* p_x_chunk;
@@ -2325,6 +2934,17 @@ void dbl_order_insertion(const r_ssize size,
 
 // -----------------------------------------------------------------------------
 
+static void dbl_order_radix_parallel(const r_ssize size,
+                                     const uint8_t pass,
+                                     uint64_t* p_x,
+                                     int* p_o,
+                                     uint64_t* p_x_aux,
+                                     int* p_o_aux,
+                                     uint8_t* p_bytes,
+                                     bool* p_skips,
+                                     const int n_threads,
+                                     struct group_infos* p_group_infos);
+
 static uint8_t dbl_compute_skips(const uint64_t* p_x, r_ssize size, bool* p_skips);
 
 static void dbl_order_radix_recurse(const r_ssize size,
@@ -2366,6 +2986,26 @@ void dbl_order_radix(const r_ssize size,
     return;
   }
 
+  if (p_group_infos->ignore_groups) {
+    const int n_threads = vec_n_threads(size, ORDER_RADIX_PARALLEL_THRESHOLD);
+
+    if (n_threads > 1) {
+      dbl_order_radix_parallel(
+        size,
+        pass,
+        p_x,
+        p_o,
+        p_x_aux,
+        p_o_aux,
+        p_bytes,
+        p_skips,
+        n_threads,
+        p_group_infos
+      );
+      return;
+    }
+  }
+
   dbl_order_radix_recurse(
     size,
     pass,
@@ -2545,6 +3185,129 @@ void dbl_order_radix_recurse(const r_ssize size,
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Parallel version of the first pass of `dbl_order_radix_recurse()`, see
+ * `int_order_radix_parallel()`
+ */
+static
+void dbl_order_radix_parallel(const r_ssize size,
+                              const uint8_t pass,
+                              uint64_t* p_x,
+                              int* p_o,
+                              uint64_t* p_x_aux,
+                              int* p_o_aux,
+                              uint8_t* p_bytes,
+                              bool* p_skips,
+                              const int n_threads,
+                              struct group_infos* p_group_infos) {
+  uint8_t next_pass = pass + 1;
+
+  while (next_pass < DBL_MAX_RADIX_PASS && p_skips[next_pass]) {
+    ++next_pass;
+  }
+
+  const uint8_t radix = PASS_TO_RADIX(pass, DBL_MAX_RADIX_PASS);
+  const uint8_t shift = radix * 8;
+
+  // One histogram per thread for the first pass, then one full set of
+  // `counts` per thread for the recursion on the radix groups
+  const r_ssize n_counts_recurse = UINT8_MAX_SIZE * DBL_MAX_RADIX_PASS;
+
+  r_ssize* p_counts = (r_ssize*) R_alloc(n_threads * UINT8_MAX_SIZE, sizeof(r_ssize));
+  memset(p_counts, 0, n_threads * UINT8_MAX_SIZE * sizeof(r_ssize));
+
+  r_ssize* p_counts_recurse = (r_ssize*) R_alloc(n_threads * n_counts_recurse, sizeof(r_ssize));
+  memset(p_counts_recurse, 0, n_threads * n_counts_recurse * sizeof(r_ssize));
+
+  const r_ssize chunk_size = (size + n_threads - 1) / n_threads;
+
+  // Histogram for this pass
+  VCTRS_OMP_PARALLEL_FOR(n_threads)
+  for (int t = 0; t < n_threads; ++t) {
+    r_ssize* p_chunk_counts = p_counts + t * UINT8_MAX_SIZE;
+
+    const r_ssize start = t * chunk_size;
+    const r_ssize end = (start + chunk_size < size) ? start + chunk_size : size;
+
+    for (r_ssize i = start; i < end; ++i) {
+      const uint8_t byte = dbl_extract_uint64_byte(p_x[i], shift);
+      p_bytes[i] = byte;
+      ++p_chunk_counts[byte];
+    }
+  }
+
+  // Accumulate counts into starting locations for each chunk of each radix
+  // group. `p_starts` records the boundaries of the radix groups.
+  r_ssize p_starts[UINT8_MAX_SIZE + 1];
+  r_ssize cumulative = 0;
+
+  for (uint16_t i = 0; i < UINT8_MAX_SIZE; ++i) {
+    p_starts[i] = cumulative;
+
+    for (int t = 0; t < n_threads; ++t) {
+      r_ssize* p_count = p_counts + t * UINT8_MAX_SIZE + i;
+      const r_ssize count = *p_count;
+      *p_count = cumulative;
+      cumulative += count;
+    }
+  }
+
+  p_starts[UINT8_MAX_SIZE] = size;
+
+  // Place into auxiliary arrays in the correct order
+  VCTRS_OMP_PARALLEL_FOR(n_threads)
+  for (int t = 0; t < n_threads; ++t) {
+    r_ssize* p_chunk_counts = p_counts + t * UINT8_MAX_SIZE;
+
+    const r_ssize start = t * chunk_size;
+    const r_ssize end = (start + chunk_size < size) ? start + chunk_size : size;
+
+    for (r_ssize i = start; i < end; ++i) {
+      const r_ssize loc = p_chunk_counts[p_bytes[i]]++;
+      p_o_aux[loc] = p_o[i];
+      p_x_aux[loc] = p_x[i];
+    }
+  }
+
+  // Copy back over
+  memcpy(p_o, p_o_aux, size * sizeof(*p_o_aux));
+  memcpy(p_x, p_x_aux, size * sizeof(*p_x_aux));
+
+  // Nothing left to compare in any radix group
+  if (next_pass == DBL_MAX_RADIX_PASS) {
+    return;
+  }
+
+  // The size of radix groups can be very uneven, so they are handed out
+  // to threads dynamically
+  VCTRS_OMP_PARALLEL_FOR_DYNAMIC(n_threads)
+  for (int i = 0; i < UINT8_MAX_SIZE; ++i) {
+    const r_ssize start = p_starts[i];
+    const r_ssize group_size = p_starts[i + 1] - start;
+
+    if (group_size <= 1) {
+      continue;
+    }
+
+    r_ssize* p_thread_counts = p_counts_recurse + vec_thread_num() * n_counts_recurse;
+
+    dbl_order_radix_recurse(
+      group_size,
+      next_pass,
+      p_x + start,
+      p_o + start,
+      p_x_aux + start,
+      p_o_aux + start,
+      p_bytes + start,
+      p_thread_counts + next_pass * UINT8_MAX_SIZE,
+      p_skips,
+      p_group_infos
+    );
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 /*
  * Detect completely skippable bytes
  *
@@ -2806,7 +3569,10 @@ static void chr_mark_sorted_uniques(const SEXP* p_x,
                                     struct lazy_raw* p_lazy_bytes,
                                     struct truelength_info* p_truelength_info);
 
-static inline void chr_extract_ordering(const SEXP* p_x, r_ssize size, int* p_x_aux);
+static inline void chr_extract_ordering(const SEXP* p_x,
+                                        r_ssize size,
+                                        int* p_x_aux,
+                                        const struct truelength_info* p_truelength_info);
 
 static void chr_order_radix(const r_ssize size,
                             const R_len_t max_size,
@@ -2849,7 +3615,9 @@ void chr_order_chunk(bool decreasing,
                      struct lazy_raw* p_lazy_o_aux,
                      struct lazy_raw* p_lazy_bytes,
                      struct lazy_raw* p_lazy_counts,
-                     struct group_infos* p_group_infos) {
+                     r_ssize* p_counting_counts,
+                     struct group_infos* p_group_infos,
+                     const struct truelength_info* p_truelength_info) {
   void* p_x_chunk = p_lazy_x_chunk->p_data;
 
   const enum vctrs_sortedness sortedness = chr_sortedness(
@@ -2869,7 +3637,7 @@ void chr_order_chunk(bool decreasing,
 
   // Move integer ordering into `p_x_aux`.
   // `p_x_aux` is allocated as the larger of `int` and `SEXP*`.
-  chr_extract_ordering(p_x_chunk, size, p_x_aux);
+  chr_extract_ordering(p_x_chunk, size, p_x_aux, p_truelength_info);
 
   /*
    * Call integer ordering algorithm on TRUELENGTHs. Reuse the chunk memory of
@@ -2887,6 +3655,7 @@ void chr_order_chunk(bool decreasing,
     p_lazy_o_aux,
     p_lazy_bytes,
     p_lazy_counts,
+    p_counting_counts,
     p_group_infos
   );
 }
@@ -3047,7 +3816,7 @@ void chr_order_internal(SEXP x,
 
   // Move integer ordering into `p_x_chunk`.
   // `p_x_chunk` is allocated as the larger of `int` and `SEXP*`.
-  chr_extract_ordering(p_x, size, p_x_chunk);
+  chr_extract_ordering(p_x, size, p_x_chunk, p_truelength_info);
 
   /*
    * Call integer ordering algorithm on TRUELENGTHs.
@@ -3079,9 +3848,27 @@ void chr_order_internal(SEXP x,
  * Pull ordering off of marked `p_x` and place it into `p_x_aux` working memory.
  * We mark the CHARSXP TRUELENGTHs with negative ordering to be different from
  * what R might use, so that gets reversed here to get the true ordering back.
+ * The private hash table stores the ordering as is.
  */
 static inline
-void chr_extract_ordering(const SEXP* p_x, r_ssize size, int* p_x_aux) {
+void chr_extract_ordering(const SEXP* p_x,
+                          r_ssize size,
+                          int* p_x_aux,
+                          const struct truelength_info* p_truelength_info) {
+  if (p_truelength_info->use_hash) {
+    for (r_ssize i = 0; i < size; ++i) {
+      SEXP elt = p_x[i];
+
+      if (elt == NA_STRING) {
+        p_x_aux[i] = NA_INTEGER;
+      } else {
+        p_x_aux[i] = (int) truelength_hash_find(elt, p_truelength_info)->value;
+      }
+    }
+
+    return;
+  }
+
   for (r_ssize i = 0; i < size; ++i) {
     SEXP elt = p_x[i];
 
@@ -3101,6 +3888,9 @@ void chr_extract_ordering(const SEXP* p_x, r_ssize size, int* p_x_aux) {
 static void chr_mark_uniques(const SEXP* p_x,
                              r_ssize size,
                              struct truelength_info* p_truelength_info);
+static void chr_mark_uniques_hash(const SEXP* p_x,
+                                  r_ssize size,
+                                  struct truelength_info* p_truelength_info);
 
 /*
  * `chr_mark_sorted_uniques()` runs through the strings in `p_x` and places the
@@ -3119,6 +3909,11 @@ static void chr_mark_uniques(const SEXP* p_x,
  * `truelength_save()` also saves the unique strings and their original
  * TRUELENGTH values so they can be reset after each column with
  * `truelength_reset()`.
+ *
+ * When `p_truelength_info->use_hash` is set, the same steps mark strings in a
+ * private hash table keyed by CHARSXP address instead, and no TRUELENGTH is
+ * touched. This costs a hash lookup per element, but marked columns can then
+ * be read from multiple threads.
  */
 static
 void chr_mark_sorted_uniques(const SEXP* p_x,
@@ -3126,7 +3921,13 @@ void chr_mark_sorted_uniques(const SEXP* p_x,
                              struct lazy_raw* p_lazy_x_aux,
                              struct lazy_raw* p_lazy_bytes,
                              struct truelength_info* p_truelength_info) {
-  chr_mark_uniques(p_x, size, p_truelength_info);
+  const bool use_hash = p_truelength_info->use_hash;
+
+  if (use_hash) {
+    chr_mark_uniques_hash(p_x, size, p_truelength_info);
+  } else {
+    chr_mark_uniques(p_x, size, p_truelength_info);
+  }
 
   r_ssize n_uniques = p_truelength_info->n_uniques_used;
 
@@ -3146,6 +3947,14 @@ void chr_mark_sorted_uniques(const SEXP* p_x,
     p_bytes
   );
 
+  if (use_hash) {
+    for (r_ssize i = 0; i < n_uniques; ++i) {
+      SEXP elt = p_truelength_info->p_uniques[i];
+      truelength_hash_find(elt, p_truelength_info)->value = i + 1;
+    }
+    return;
+  }
+
   // Mark unique sorted strings with their order.
   // Use a negative value to differentiate with R.
   for (r_ssize i = 0; i < n_uniques; ++i) {
@@ -3154,6 +3963,32 @@ void chr_mark_sorted_uniques(const SEXP* p_x,
   }
 }
 
+static
+void chr_mark_uniques_hash(const SEXP* p_x,
+                           r_ssize size,
+                           struct truelength_info* p_truelength_info) {
+  for (r_ssize i = 0; i < size; ++i) {
+    SEXP elt = p_x[i];
+
+    if (elt == NA_STRING) {
+      continue;
+    }
+
+    if (!truelength_hash_insert(elt, p_truelength_info)) {
+      continue;
+    }
+
+    int elt_size = (int) r_length(elt);
+
+    if (p_truelength_info->max_string_size < elt_size) {
+      p_truelength_info->max_string_size = elt_size;
+    }
+
+    truelength_save_unique(elt, p_truelength_info);
+    truelength_save_size(elt_size, p_truelength_info);
+  }
+}
+
 static
 void chr_mark_uniques(const SEXP* p_x,
                       r_ssize size,
@@ -3916,6 +4751,29 @@ static void vec_order_chunk_switch(bool decreasing,
                                    struct truelength_info* p_truelength_info);
 
 
+static bool df_order_chunks_can_parallel(const enum vctrs_type type,
+                                         bool chr_ordered,
+                                         const struct group_info* p_group_info_pre,
+                                         const struct truelength_info* p_truelength_info,
+                                         r_ssize size);
+
+static void df_order_chunks_parallel(SEXP col,
+                                     const enum vctrs_type type,
+                                     bool decreasing,
+                                     bool na_last,
+                                     bool nan_distinct,
+                                     r_ssize size,
+                                     int n_threads,
+                                     const struct group_info* p_group_info_pre,
+                                     int* p_o,
+                                     struct lazy_raw* p_lazy_x_chunk,
+                                     struct lazy_raw* p_lazy_x_aux,
+                                     struct lazy_raw* p_lazy_o_aux,
+                                     struct lazy_raw* p_lazy_bytes,
+                                     struct lazy_raw* p_lazy_counts,
+                                     struct group_infos* p_group_infos,
+                                     const struct truelength_info* p_truelength_info);
+
 #define DF_ORDER_EXTRACT_CHUNK(CONST_DEREF, CTYPE) do {          \
   const CTYPE* p_col = CONST_DEREF(col);                         \
   CTYPE* p_x_chunk_col = (CTYPE*) p_x_chunk;                     \
@@ -4037,6 +4895,9 @@ void df_order_internal(SEXP x,
   // the real part so the column is rerun.
   bool rerun_complex = false;
 
+  // Number of threads available to order the chunks of a column
+  const int n_threads = vec_n_threads(size, ORDER_RADIX_PARALLEL_THRESHOLD);
+
   // Iterate over remaining columns by group chunk
   for (r_ssize i = 1; i < n_cols; ++i) {
     // Get the number of group chunks from previous column group info
@@ -4098,6 +4959,38 @@ void df_order_internal(SEXP x,
     // Ensure `x_chunk` is initialized to hold chunks
     void* p_x_chunk = init_lazy_raw(p_lazy_x_chunk);
 
+    const bool parallel =
+      n_threads > 1 &&
+      df_order_chunks_can_parallel(type, chr_ordered, p_group_info_pre, p_truelength_info, size);
+
+    if (parallel) {
+      df_order_chunks_parallel(
+        col,
+        type,
+        col_decreasing,
+        col_na_last,
+        nan_distinct,
+        size,
+        n_threads,
+        p_group_info_pre,
+        p_o_col,
+        p_lazy_x_chunk,
+        p_lazy_x_aux,
+        p_lazy_o_aux,
+        p_lazy_bytes,
+        p_lazy_counts,
+        p_group_infos,
+        p_truelength_info
+      );
+
+      // Empty the private string table of character columns
+      if (type == vctrs_type_character) {
+        truelength_reset(p_truelength_info);
+      }
+
+      continue;
+    }
+
     // Iterate over this column's group chunks
     for (r_ssize group = 0; group < n_groups; ++group) {
       r_ssize group_size = p_group_info_pre->p_data[group];
@@ -4153,6 +5046,283 @@ void df_order_internal(SEXP x,
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Once the previous columns have split `x` into many large groups, the
+ * chunks of the current column can be ordered independently of each other.
+ * This is done for numeric columns, and for sorted character columns marked
+ * in the private hash table of `p_truelength_info`, which chunks only read.
+ * Appearance ordering relies on TRUELENGTHs. Chunks are handed out dynamically,
+ * and the parallel path is skipped when a single group dominates since it
+ * can't be split further.
+ */
+static
+bool df_order_chunks_can_parallel(const enum vctrs_type type,
+                                  bool chr_ordered,
+                                  const struct group_info* p_group_info_pre,
+                                  const struct truelength_info* p_truelength_info,
+                                  r_ssize size) {
+  switch (type) {
+  case vctrs_type_integer:
+  case vctrs_type_logical:
+  case vctrs_type_double:
+    break;
+  case vctrs_type_character:
+    if (chr_ordered && p_truelength_info->use_hash) {
+      break;
+    }
+    return false;
+  default:
+    return false;
+  }
+
+  const r_ssize max_group_size = p_group_info_pre->max_group_size;
+
+  return
+    max_group_size > ORDER_INSERTION_BOUNDARY &&
+    max_group_size <= size / 2;
+}
+
+static inline
+void* ptr_offset(void* p, r_ssize offset) {
+  return (void*) ((unsigned char*) p + offset);
+}
+
+/*
+ * Each chunk is ordered with the serial chunk functions, using views of the
+ * working memory at the chunk's location so that chunks never overlap. The
+ * working memory is fully initialized beforehand so that `init_lazy_raw()`
+ * doesn't allocate from a thread. `counts` is the only working memory
+ * indexed from zero by every chunk, so each thread gets its own.
+ *
+ * Group sizes are recorded by each chunk at its own location through a
+ * local `group_infos`, and pushed in order once all chunks are done.
+ */
+static
+void df_order_chunks_parallel(SEXP col,
+                              const enum vctrs_type type,
+                              bool decreasing,
+                              bool na_last,
+                              bool nan_distinct,
+                              r_ssize size,
+                              int n_threads,
+                              const struct group_info* p_group_info_pre,
+                              int* p_o,
+                              struct lazy_raw* p_lazy_x_chunk,
+                              struct lazy_raw* p_lazy_x_aux,
+                              struct lazy_raw* p_lazy_o_aux,
+                              struct lazy_raw* p_lazy_bytes,
+                              struct lazy_raw* p_lazy_counts,
+                              struct group_infos* p_group_infos,
+                              const struct truelength_info* p_truelength_info) {
+  const r_ssize n_groups = p_group_info_pre->n_groups;
+  const int* p_sizes = p_group_info_pre->p_data;
+
+  const void* p_col;
+  size_t elt_size;
+
+  switch (type) {
+  case vctrs_type_integer: p_col = INTEGER_RO(col); elt_size = sizeof(int); break;
+  case vctrs_type_logical: p_col = LOGICAL_RO(col); elt_size = sizeof(int); break;
+  case vctrs_type_double: p_col = REAL_RO(col); elt_size = sizeof(double); break;
+  case vctrs_type_character: p_col = STRING_PTR_RO(col); elt_size = sizeof(SEXP); break;
+  default: stop_unimplemented_vctrs_type("df_order_chunks_parallel", type);
+  }
+
+  void* p_x_chunk = init_lazy_raw(p_lazy_x_chunk);
+  void* p_x_aux = init_lazy_raw(p_lazy_x_aux);
+  void* p_o_aux = init_lazy_raw(p_lazy_o_aux);
+  void* p_bytes = init_lazy_raw(p_lazy_bytes);
+
+  // The chunk kernels call `init_lazy_raw()` on the counts, which must
+  // not allocate on a worker thread. Allocating the shared counts here
+  // makes the per-thread views below non-lazy, so they only ever
+  // return their own `p_data`.
+  init_lazy_raw(p_lazy_counts);
+
+  const r_ssize counts_size = p_lazy_counts->size;
+  void* p_counts = R_alloc(n_threads, counts_size);
+
+  // Each thread needs its own counting sort buckets. These are only used
+  // by integer, logical, and character chunks.
+  const r_ssize counting_counts_size = INT_ORDER_COUNTING_RANGE_BOUNDARY + 1;
+  r_ssize* p_counting_counts = NULL;
+
+  if (type != vctrs_type_double) {
+    p_counting_counts = (r_ssize*) R_alloc(n_threads * counting_counts_size, sizeof(r_ssize));
+    memset(p_counting_counts, 0, n_threads * counting_counts_size * sizeof(r_ssize));
+  }
+
+  r_ssize* p_starts = (r_ssize*) R_alloc(n_groups, sizeof(r_ssize));
+  r_ssize cumulative = 0;
+
+  for (r_ssize i = 0; i < n_groups; ++i) {
+    p_starts[i] = cumulative;
+    cumulative += p_sizes[i];
+  }
+
+  const bool ignore_groups = p_group_infos->ignore_groups;
+
+  int* p_chunk_sizes = NULL;
+  r_ssize* p_chunk_n_groups = NULL;
+
+  if (!ignore_groups) {
+    p_chunk_sizes = (int*) R_alloc(size, sizeof(int));
+    p_chunk_n_groups = (r_ssize*) R_alloc(n_groups, sizeof(r_ssize));
+  }
+
+  VCTRS_OMP_PARALLEL_FOR_DYNAMIC(n_threads)
+  for (r_ssize group = 0; group < n_groups; ++group) {
+    const r_ssize start = p_starts[group];
+    const r_ssize group_size = p_sizes[group];
+
+    struct group_info chunk_group_info = {
+      .self = R_NilValue,
+      .data = R_NilValue,
+      .p_data = ignore_groups ? NULL : p_chunk_sizes + start,
+      .data_size = group_size,
+      .n_groups = 0,
+      .max_group_size = 0
+    };
+
+    struct group_info* p_p_chunk_group_info[2] = {
+      &chunk_group_info,
+      &chunk_group_info
+    };
+
+    struct group_infos chunk_group_infos = {
+      .self = R_NilValue,
+      .p_p_group_info_data = R_NilValue,
+      .p_p_group_info = p_p_chunk_group_info,
+      .max_data_size = group_size,
+      .current = 0,
+      .force_groups = p_group_infos->force_groups,
+      .ignore_groups = ignore_groups
+    };
+
+    int* p_o_chunk = p_o + start;
+
+    if (group_size == 1) {
+      groups_size_maybe_push(1, &chunk_group_infos);
+    } else {
+      struct lazy_raw lazy_x_chunk = *p_lazy_x_chunk;
+      lazy_x_chunk.p_data = ptr_offset(p_x_chunk, start * elt_size);
+
+      struct lazy_raw lazy_x_aux = *p_lazy_x_aux;
+      lazy_x_aux.p_data = ptr_offset(p_x_aux, start * elt_size);
+
+      struct lazy_raw lazy_o_aux = *p_lazy_o_aux;
+      lazy_o_aux.p_data = ptr_offset(p_o_aux, start * sizeof(int));
+
+      struct lazy_raw lazy_bytes = *p_lazy_bytes;
+      lazy_bytes.p_data = ptr_offset(p_bytes, start * sizeof(uint8_t));
+
+      struct lazy_raw lazy_counts = *p_lazy_counts;
+      lazy_counts.p_data = ptr_offset(p_counts, vec_thread_num() * counts_size);
+
+      r_ssize* p_thread_counting_counts = (type == vctrs_type_double) ?
+        NULL :
+        p_counting_counts + vec_thread_num() * counting_counts_size;
+
+      // Extract current chunk and place into `x_chunk` in sequential order
+      switch (type) {
+      case vctrs_type_integer:
+      case vctrs_type_logical: {
+        const int* p_col_int = (const int*) p_col;
+        int* p_x_chunk_int = (int*) lazy_x_chunk.p_data;
+
+        for (r_ssize j = 0; j < group_size; ++j) {
+          p_x_chunk_int[j] = p_col_int[p_o_chunk[j] - 1];
+        }
+        break;
+      }
+      case vctrs_type_double: {
+        const double* p_col_dbl = (const double*) p_col;
+        double* p_x_chunk_dbl = (double*) lazy_x_chunk.p_data;
+
+        for (r_ssize j = 0; j < group_size; ++j) {
+          p_x_chunk_dbl[j] = p_col_dbl[p_o_chunk[j] - 1];
+        }
+        break;
+      }
+      default: {
+        const SEXP* p_col_chr = (const SEXP*) p_col;
+        SEXP* p_x_chunk_chr = (SEXP*) lazy_x_chunk.p_data;
+
+        for (r_ssize j = 0; j < group_size; ++j) {
+          p_x_chunk_chr[j] = p_col_chr[p_o_chunk[j] - 1];
+        }
+        break;
+      }
+      }
+
+      if (type == vctrs_type_character) {
+        chr_order_chunk(
+          decreasing,
+          na_last,
+          group_size,
+          p_o_chunk,
+          &lazy_x_chunk,
+          &lazy_x_aux,
+          &lazy_o_aux,
+          &lazy_bytes,
+          &lazy_counts,
+          p_thread_counting_counts,
+          &chunk_group_infos,
+          p_truelength_info
+        );
+      } else if (type == vctrs_type_double) {
+        dbl_order_chunk(
+          decreasing,
+          na_last,
+          nan_distinct,
+          group_size,
+          p_o_chunk,
+          &lazy_x_chunk,
+          &lazy_x_aux,
+          &lazy_o_aux,
+          &lazy_bytes,
+          &lazy_counts,
+          &chunk_group_infos
+        );
+      } else {
+        int_order_chunk(
+          decreasing,
+          na_last,
+          group_size,
+          p_o_chunk,
+          &lazy_x_chunk,
+          &lazy_x_aux,
+          &lazy_o_aux,
+          &lazy_bytes,
+          &lazy_counts,
+          p_thread_counting_counts,
+          &chunk_group_infos
+        );
+      }
+    }
+
+    if (!ignore_groups) {
+      p_chunk_n_groups[group] = chunk_group_info.n_groups;
+    }
+  }
+
+  if (ignore_groups) {
+    return;
+  }
+
+  // Push the group sizes of each chunk in order
+  for (r_ssize group = 0; group < n_groups; ++group) {
+    const int* p_chunk_sizes_group = p_chunk_sizes + p_starts[group];
+    const r_ssize n_chunk_groups = p_chunk_n_groups[group];
+
+    for (r_ssize j = 0; j < n_chunk_groups; ++j) {
+      groups_size_push(p_chunk_sizes_group[j], p_group_infos);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 /*
  * Switch function specifically for column chunks generated when
  * processing a data frame
@@ -4184,6 +5354,7 @@ void vec_order_chunk_switch(bool decreasing,
       p_lazy_o_aux,
       p_lazy_bytes,
       p_lazy_counts,
+      int_order_counting_counts,
       p_group_infos
     );
 
@@ -4200,6 +5371,7 @@ void vec_order_chunk_switch(bool decreasing,
       p_lazy_o_aux,
       p_lazy_bytes,
       p_lazy_counts,
+      int_order_counting_counts,
       p_group_infos
     );
 
@@ -4252,7 +5424,9 @@ void vec_order_chunk_switch(bool decreasing,
         p_lazy_o_aux,
         p_lazy_bytes,
         p_lazy_counts,
-        p_group_infos
+        int_order_counting_counts,
+        p_group_infos,
+        p_truelength_info
       );
     } else {
       chr_appearance_chunk(
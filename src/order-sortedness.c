@@ -468,6 +468,209 @@ int chr_cmp(SEXP x,
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Maximum number of presorted runs that are merged by `int_order_runs()` and
+ * `dbl_order_runs()`. Run detection stops as soon as more runs are found, so
+ * unstructured input only pays for a short scan before falling back to the
+ * radix ordering.
+ */
+#define ORDER_RUNS_MAX 16
+
+/*
+ * Merge the runs delimited by `p_starts` pairwise, ping-ponging between
+ * `p_o` and `p_o_aux`, until a single run remains in `p_o`. Merging takes
+ * from the left run on ties, so the result is stable. Group sizes are pushed
+ * afterwards by comparing neighbouring elements of the final ordering.
+ *
+ * `CMP(I, J)` compares the elements at 0-based locations `I` and `J`.
+ */
+#define ORD_MERGE_RUNS(CMP) do {                                       \
+  for (r_ssize i = 0; i < size; ++i) {                                 \
+    p_o[i] = i + 1;                                                    \
+  }                                                                    \
+                                                                       \
+  int* p_src = p_o;                                                    \
+  int* p_dst = p_o_aux;                                                \
+                                                                       \
+  while (n_runs > 1) {                                                 \
+    r_ssize n_merged = 0;                                              \
+                                                                       \
+    for (r_ssize run = 0; run < n_runs; run += 2) {                    \
+      const r_ssize start = p_starts[run];                             \
+                                                                       \
+      if (run + 1 == n_runs) {                                         \
+        const r_ssize end = p_starts[run + 1];                         \
+        memcpy(p_dst + start, p_src + start, (end - start) * sizeof(int)); \
+        p_starts[n_merged] = start;                                    \
+        ++n_merged;                                                    \
+        continue;                                                      \
+      }                                                                \
+                                                                       \
+      const r_ssize mid = p_starts[run + 1];                           \
+      const r_ssize end = p_starts[run + 2];                           \
+                                                                       \
+      r_ssize i = start;                                               \
+      r_ssize j = mid;                                                 \
+      r_ssize k = start;                                               \
+                                                                       \
+      while (i < mid && j < end) {                                     \
+        if (CMP(p_src[j] - 1, p_src[i] - 1) < 0) {                     \
+          p_dst[k++] = p_src[j++];                                     \
+        } else {                                                       \
+          p_dst[k++] = p_src[i++];                                     \
+        }                                                              \
+      }                                                                \
+      while (i < mid) {                                                \
+        p_dst[k++] = p_src[i++];                                       \
+      }                                                                \
+      while (j < end) {                                                \
+        p_dst[k++] = p_src[j++];                                       \
+      }                                                                \
+                                                                       \
+      p_starts[n_merged] = start;                                      \
+      ++n_merged;                                                      \
+    }                                                                  \
+                                                                       \
+    p_starts[n_merged] = size;                                         \
+    n_runs = n_merged;                                                 \
+                                                                       \
+    int* p_tmp = p_src;                                                \
+    p_src = p_dst;                                                     \
+    p_dst = p_tmp;                                                     \
+  }                                                                    \
+                                                                       \
+  if (p_src != p_o) {                                                  \
+    memcpy(p_o, p_src, size * sizeof(int));                            \
+  }                                                                    \
+                                                                       \
+  if (!p_group_infos->ignore_groups) {                                 \
+    r_ssize group_size = 1;                                            \
+                                                                       \
+    for (r_ssize i = 1; i < size; ++i) {                               \
+      if (CMP(p_o[i] - 1, p_o[i - 1] - 1) == 0) {                      \
+        ++group_size;                                                  \
+        continue;                                                      \
+      }                                                                \
+                                                                       \
+      groups_size_push(group_size, p_group_infos);                     \
+      group_size = 1;                                                  \
+    }                                                                  \
+                                                                       \
+    groups_size_push(group_size, p_group_infos);                       \
+  }                                                                    \
+} while (0)
+
+/*
+ * Order `p_x` by merging its presorted runs, for input that is made of a few
+ * sorted chunks appended together, like time series collected in batches.
+ * This is called after `int_sortedness()` has reported the input as unsorted,
+ * so there are always at least two runs.
+ *
+ * Returns `false` without touching `p_o` if there are more than
+ * `ORDER_RUNS_MAX` runs. Otherwise `p_o` is initialized with the ordering and
+ * the group sizes are pushed.
+ */
+bool int_order_runs(const int* p_x,
+                    r_ssize size,
+                    bool decreasing,
+                    bool na_last,
+                    int* p_o,
+                    struct lazy_raw* p_lazy_o_aux,
+                    struct group_infos* p_group_infos) {
+  const int direction = decreasing ? -1 : 1;
+  const int na_order = na_last ? 1 : -1;
+
+  r_ssize p_starts[ORDER_RUNS_MAX + 1];
+  p_starts[0] = 0;
+  r_ssize n_runs = 1;
+
+  for (r_ssize i = 1; i < size; ++i) {
+    if (int_cmp(p_x[i], p_x[i - 1], direction, na_order) >= 0) {
+      continue;
+    }
+    if (n_runs == ORDER_RUNS_MAX) {
+      return false;
+    }
+    p_starts[n_runs] = i;
+    ++n_runs;
+  }
+
+  p_starts[n_runs] = size;
+
+  int* p_o_aux = (int*) init_lazy_raw(p_lazy_o_aux);
+
+#define INT_RUNS_CMP(I, J) int_cmp(p_x[I], p_x[J], direction, na_order)
+  ORD_MERGE_RUNS(INT_RUNS_CMP);
+#undef INT_RUNS_CMP
+
+  return true;
+}
+
+// Very similar to `int_order_runs()`
+bool dbl_order_runs(const double* p_x,
+                    r_ssize size,
+                    bool decreasing,
+                    bool na_last,
+                    bool nan_distinct,
+                    int* p_o,
+                    struct lazy_raw* p_lazy_o_aux,
+                    struct group_infos* p_group_infos) {
+  const int direction = decreasing ? -1 : 1;
+  const int na_order = na_last ? 1 : -1;
+  const int na_nan_order = nan_distinct ? na_order : 0;
+
+  r_ssize p_starts[ORDER_RUNS_MAX + 1];
+  p_starts[0] = 0;
+  r_ssize n_runs = 1;
+
+  for (r_ssize i = 1; i < size; ++i) {
+    const double current = p_x[i];
+    const double previous = p_x[i - 1];
+
+    const int cmp = dbl_cmp(
+      current,
+      previous,
+      dbl_classify(current),
+      dbl_classify(previous),
+      direction,
+      na_order,
+      na_nan_order
+    );
+
+    if (cmp >= 0) {
+      continue;
+    }
+    if (n_runs == ORDER_RUNS_MAX) {
+      return false;
+    }
+    p_starts[n_runs] = i;
+    ++n_runs;
+  }
+
+  p_starts[n_runs] = size;
+
+  int* p_o_aux = (int*) init_lazy_raw(p_lazy_o_aux);
+
+#define DBL_RUNS_CMP(I, J) dbl_cmp(     \
+  p_x[I],                               \
+  p_x[J],                               \
+  dbl_classify(p_x[I]),                 \
+  dbl_classify(p_x[J]),                 \
+  direction,                            \
+  na_order,                             \
+  na_nan_order                          \
+)
+  ORD_MERGE_RUNS(DBL_RUNS_CMP);
+#undef DBL_RUNS_CMP
+
+  return true;
+}
+
+#undef ORD_MERGE_RUNS
+#undef ORDER_RUNS_MAX
+
+// -----------------------------------------------------------------------------
+
 static inline void int_incr(r_ssize size, int* p_x);
 static inline void ord_reverse(r_ssize size, int* p_o);
 
@@ -15,6 +15,7 @@
 
 #include "vctrs.h"
 #include "order-groups.h"
+#include "lazy.h"
 
 // -----------------------------------------------------------------------------
 
@@ -47,6 +48,25 @@ enum vctrs_sortedness chr_sortedness(const SEXP* p_x,
 
 // -----------------------------------------------------------------------------
 
+bool int_order_runs(const int* p_x,
+                    r_ssize size,
+                    bool decreasing,
+                    bool na_last,
+                    int* p_o,
+                    struct lazy_raw* p_lazy_o_aux,
+                    struct group_infos* p_group_infos);
+
+bool dbl_order_runs(const double* p_x,
+                    r_ssize size,
+                    bool decreasing,
+                    bool na_last,
+                    bool nan_distinct,
+                    int* p_o,
+                    struct lazy_raw* p_lazy_o_aux,
+                    struct group_infos* p_group_infos);
+
+// -----------------------------------------------------------------------------
+
 void ord_resolve_sortedness(enum vctrs_sortedness sortedness,
                             r_ssize size,
                             int* p_o);
@@ -52,6 +52,11 @@ struct truelength_info* new_truelength_info(r_ssize n_max) {
 
   p_truelength_info->n_max = n_max;
 
+  p_truelength_info->use_hash = false;
+  p_truelength_info->hash = vctrs_shared_empty_raw;
+  p_truelength_info->p_hash = NULL;
+  p_truelength_info->hash_size = 0;
+
   UNPROTECT(1);
   return p_truelength_info;
 }
@@ -74,11 +79,25 @@ struct truelength_info* new_truelength_info(r_ssize n_max) {
  *
  * This will be called after each character data frame column is processed, and
  * at the end of `chr_order()` for a single character vector.
+ *
+ * When the private hash table is used, no TRUELENGTHs were modified and the
+ * table is emptied instead.
  */
 void truelength_reset(struct truelength_info* p_truelength_info) {
   r_ssize n_uniques_used = p_truelength_info->n_uniques_used;
   r_ssize n_strings_used = p_truelength_info->n_strings_used;
 
+  if (p_truelength_info->use_hash) {
+    if (n_uniques_used != 0) {
+      memset(
+        p_truelength_info->p_hash,
+        0,
+        p_truelength_info->hash_size * sizeof(struct truelength_hash_slot)
+      );
+    }
+    n_uniques_used = 0;
+  }
+
   // First reset uniques
   for (r_ssize i = 0; i < n_uniques_used; ++i) {
     SEXP unique = p_truelength_info->p_uniques[i];
@@ -101,6 +120,62 @@ void truelength_reset(struct truelength_info* p_truelength_info) {
 
 // -----------------------------------------------------------------------------
 
+// Initial number of slots of the private hash table
+#define TRUELENGTH_HASH_SIZE_DEFAULT 1024
+
+static void truelength_hash_grow(struct truelength_info* p_truelength_info);
+
+/*
+ * Insert `string` in the private hash table if it isn't already there.
+ * Returns `true` if it was inserted. The table is kept at most half full.
+ */
+bool truelength_hash_insert(SEXP string, struct truelength_info* p_truelength_info) {
+  if (2 * (p_truelength_info->n_uniques_used + 1) > p_truelength_info->hash_size) {
+    truelength_hash_grow(p_truelength_info);
+  }
+
+  struct truelength_hash_slot* p_slot = truelength_hash_find(string, p_truelength_info);
+
+  if (p_slot->key != NULL) {
+    return false;
+  }
+
+  p_slot->key = string;
+  p_slot->value = 0;
+
+  return true;
+}
+
+static
+void truelength_hash_grow(struct truelength_info* p_truelength_info) {
+  const r_ssize old_size = p_truelength_info->hash_size;
+  struct truelength_hash_slot* p_old = p_truelength_info->p_hash;
+
+  const r_ssize size = old_size == 0 ? TRUELENGTH_HASH_SIZE_DEFAULT : old_size * 2;
+
+  SEXP hash = Rf_allocVector(RAWSXP, size * sizeof(struct truelength_hash_slot));
+  REPROTECT(hash, p_truelength_info->hash_pi);
+
+  struct truelength_hash_slot* p_hash = (struct truelength_hash_slot*) RAW(hash);
+  memset(p_hash, 0, size * sizeof(struct truelength_hash_slot));
+
+  p_truelength_info->hash = hash;
+  p_truelength_info->p_hash = p_hash;
+  p_truelength_info->hash_size = size;
+
+  // Reinsert the existing strings. The old table is no longer protected,
+  // but nothing allocates until we are done reading it.
+  for (r_ssize i = 0; i < old_size; ++i) {
+    const struct truelength_hash_slot old = p_old[i];
+
+    if (old.key != NULL) {
+      *truelength_hash_find(old.key, p_truelength_info) = old;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 static r_ssize truelength_realloc_size(r_ssize n_x, r_ssize n_max);
 
 static inline SEXP truelengths_resize(SEXP x, r_ssize x_size, r_ssize size);
@@ -24,6 +24,15 @@
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Slot of the private string table used instead of the CHARSXP TRUELENGTHs
+ * when `use_hash` is set. `key` is `NULL` for empty slots.
+ */
+struct truelength_hash_slot {
+  SEXP key;
+  r_ssize value;
+};
+
 /*
  * Struct of information required to track unique strings and their truelengths
  * when ordering them
@@ -57,6 +66,14 @@
  * @member n_max The maximum allowed allocation size for the SEXP
  *   objects in this struct. Always set to the size of `x`, which would occur if
  *   all strings were unique.
+ *
+ * @member use_hash Whether to mark strings in a private pointer-keyed hash
+ *   table rather than in their TRUELENGTH. The table is only read while
+ *   extracting the ordering, so chunks can then be ordered from multiple
+ *   threads, and nothing global is modified.
+ * @members hash,p_hash,hash_pi The hash table, a RAWSXP of
+ *   `truelength_hash_slot`. Grown by `truelength_hash_insert()`.
+ * @member hash_size The number of slots of `hash`. Always a power of 2.
  */
 struct truelength_info {
   SEXP self;
@@ -96,6 +113,15 @@ struct truelength_info {
 
 
   r_ssize n_max;
+
+
+  bool use_hash;
+
+  SEXP hash;
+  struct truelength_hash_slot* p_hash;
+  PROTECT_INDEX hash_pi;
+
+  r_ssize hash_size;
 };
 
 #define PROTECT_TRUELENGTH_INFO(p_info, p_n) do {                       \
@@ -105,7 +131,8 @@ struct truelength_info {
   PROTECT_WITH_INDEX((p_info)->uniques, &(p_info)->uniques_pi);         \
   PROTECT_WITH_INDEX((p_info)->sizes, &(p_info)->sizes_pi);             \
   PROTECT_WITH_INDEX((p_info)->sizes_aux, &(p_info)->sizes_aux_pi);     \
-  *(p_n) += 6;                                                          \
+  PROTECT_WITH_INDEX((p_info)->hash, &(p_info)->hash_pi);               \
+  *(p_n) += 7;                                                          \
 } while(0)
 
 
@@ -148,5 +175,39 @@ void truelength_save_size(int size,
   ++p_truelength_info->n_sizes_used;
 }
 
+// -----------------------------------------------------------------------------
+
+bool truelength_hash_insert(SEXP string, struct truelength_info* p_truelength_info);
+
+static inline
+uint64_t truelength_hash_ptr(SEXP string) {
+  // CHARSXPs are at least 8 byte aligned, so the low bits carry no entropy.
+  // Fibonacci hashing mixes the rest into the high bits.
+  return (((uintptr_t) string) >> 3) * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+/*
+ * Find the slot of `string`, or the empty slot where it belongs. Only reads
+ * the table, so this is safe to call from multiple threads at once.
+ */
+static inline
+struct truelength_hash_slot* truelength_hash_find(SEXP string,
+                                                  const struct truelength_info* p_truelength_info) {
+  const uint64_t mask = p_truelength_info->hash_size - 1;
+  struct truelength_hash_slot* p_hash = p_truelength_info->p_hash;
+
+  uint64_t i = truelength_hash_ptr(string) >> 32 & mask;
+
+  while (true) {
+    struct truelength_hash_slot* p_slot = p_hash + i;
+
+    if (p_slot->key == string || p_slot->key == NULL) {
+      return p_slot;
+    }
+
+    i = (i + 1) & mask;
+  }
+}
+
 // -----------------------------------------------------------------------------
 #endif
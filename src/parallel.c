@@ -0,0 +1,32 @@
+#include <rlang.h>
+#include "vctrs.h"
+#include "parallel.h"
+#include "utils.h"
+
+// [[ include("parallel.h") ]]
+int vec_n_threads(r_ssize size, r_ssize threshold) {
+#ifdef _OPENMP
+  if (size < threshold || omp_in_parallel()) {
+    return 1;
+  }
+
+  SEXP opt = r_peek_option("vctrs.num_threads");
+  if (opt == R_NilValue) {
+    return 1;
+  }
+
+  int n_threads = Rf_asInteger(opt);
+  if (n_threads == NA_INTEGER || n_threads < 1) {
+    Rf_errorcall(R_NilValue, "`vctrs.num_threads` must be a positive integer.");
+  }
+
+  int n_procs = omp_get_num_procs();
+  if (n_threads > n_procs) {
+    n_threads = n_procs;
+  }
+
+  return n_threads;
+#else
+  return 1;
+#endif
+}
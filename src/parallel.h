@@ -0,0 +1,74 @@
+#ifndef VCTRS_PARALLEL_H
+#define VCTRS_PARALLEL_H
+
+#include "vctrs.h"
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+// -----------------------------------------------------------------------------
+
+/*
+ * OpenMP pragmas are wrapped in `VCTRS_OMP()` so that they expand to
+ * nothing (rather than to an unknown pragma warning) when vctrs is
+ * compiled without OpenMP support, e.g. with Apple clang.
+ *
+ * `VCTRS_OMP_PARALLEL_FOR()` statically splits the following `for`
+ * loop across `n_threads` threads, and runs it serially on the calling
+ * thread when `n_threads` is 1:
+ *
+ * const int n_threads = vec_n_threads(size, THRESHOLD);
+ * VCTRS_OMP_PARALLEL_FOR(n_threads)
+ * for (r_ssize i = 0; i < size; ++i) { ... }
+ *
+ * Code running in a parallel region must never call the R API, which
+ * includes allocation, protection, `*_ELT()` accessors and errors.
+ * Pointers to vector data must be taken beforehand on the main thread.
+ */
+#ifdef _OPENMP
+# define VCTRS_PRAGMA(...) _Pragma(#__VA_ARGS__)
+# define VCTRS_OMP(...) VCTRS_PRAGMA(omp __VA_ARGS__)
+# define VCTRS_OMP_PARALLEL_FOR(N_THREADS) \
+  VCTRS_OMP(parallel for num_threads(N_THREADS) schedule(static) if(N_THREADS > 1))
+# define VCTRS_OMP_PARALLEL_FOR_DYNAMIC(N_THREADS) \
+  VCTRS_OMP(parallel for num_threads(N_THREADS) schedule(dynamic) if(N_THREADS > 1))
+#else
+# define VCTRS_OMP(...)
+# define VCTRS_OMP_PARALLEL_FOR(N_THREADS) (void) (N_THREADS);
+# define VCTRS_OMP_PARALLEL_FOR_DYNAMIC(N_THREADS) (void) (N_THREADS);
+#endif
+
+/*
+ * `VCTRS_OMP_PARALLEL_FOR_DYNAMIC()` hands out iterations to threads as
+ * they become idle. Use it when iterations have very uneven costs.
+ *
+ * `vec_thread_num()` is the index of the calling thread within the
+ * current parallel region, from 0 to `n_threads - 1`. It is useful to
+ * pick per-thread scratch memory allocated beforehand. Code that may run
+ * in a parallel region must not use static scratch buffers.
+ */
+static inline
+int vec_thread_num(void) {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+/*
+ * Number of threads to use for a loop over `size` elements
+ *
+ * Returns 1 when `size` is smaller than `threshold` or when vctrs was
+ * built without OpenMP. Otherwise returns the value of the
+ * `vctrs.num_threads` global option, capped to the number of
+ * processors available to OpenMP. The option is read on every call
+ * and defaults to 1, i.e. parallelism is opt-in.
+ *
+ * Returns 1 without touching the R API when called from a parallel
+ * region, so nested loops run serially within their thread.
+ */
+int vec_n_threads(r_ssize size, r_ssize threshold);
+
+#endif
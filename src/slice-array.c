@@ -293,6 +293,10 @@ SEXP vec_slice_shaped_base(enum vctrs_type type,
 SEXP vec_slice_shaped(enum vctrs_type type, SEXP x, SEXP index) {
   int n_protect = 0;
 
+  if (is_compact_runs(index)) {
+    index = PROTECT_N(compact_materialize(index), &n_protect);
+  }
+
   struct strides_info info = new_strides_info(x, index);
   PROTECT_STRIDES_INFO(&info, &n_protect);
 
@@ -220,6 +220,10 @@ SEXP vec_assign_shaped(SEXP proxy, SEXP index, SEXP value,
                        const struct vec_assign_opts* opts) {
   int n_protect = 0;
 
+  if (is_compact_runs(index)) {
+    index = PROTECT_N(compact_materialize(index), &n_protect);
+  }
+
   struct strides_info info = new_strides_info(proxy, index);
   PROTECT_STRIDES_INFO(&info, &n_protect);
 
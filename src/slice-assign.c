@@ -36,14 +36,14 @@ SEXP vec_assign_opts(SEXP x, SEXP index, SEXP value,
   vec_assert(x, opts->x_arg);
   vec_assert(value, opts->value_arg);
 
-  index = PROTECT(vec_as_location_opts(index,
-                                       vec_size(x),
-                                       PROTECT(vec_names(x)),
-                                       location_default_assign_opts));
+  index = PROTECT(vec_as_location_compact(index,
+                                          vec_size(x),
+                                          PROTECT(vec_names(x)),
+                                          location_default_assign_opts));
 
   // Cast and recycle `value`
   value = PROTECT(vec_cast(value, x, opts->value_arg, opts->x_arg));
-  value = PROTECT(vec_recycle(value, vec_size(index), opts->value_arg));
+  value = PROTECT(vec_recycle(value, vec_subscript_size(index), opts->value_arg));
 
   SEXP proxy = PROTECT(vec_proxy(x));
   const enum vctrs_owned owned = vec_owned(proxy);
@@ -78,6 +78,83 @@ SEXP vctrs_assign_params(SEXP x, SEXP index, SEXP value,
   return vec_assign_opts(x, index, value, &opts);
 }
 
+/*
+ * Applies several `(index, value)` patches to `x`. Unlike repeated calls
+ * to `vec_assign()`, `x` is proxied and restored once, and cloned at most
+ * once: the first assignment copies `x` if it is referenced, and the
+ * following ones assign in place into that copy.
+ *
+ * [[ include("slice-assign.h") ]]
+ */
+SEXP vec_assign_many_opts(SEXP x, SEXP indices, SEXP values,
+                          const struct vec_assign_opts* opts) {
+  if (TYPEOF(indices) != VECSXP || TYPEOF(values) != VECSXP) {
+    Rf_errorcall(R_NilValue, "`indices` and `values` must be lists.");
+  }
+
+  R_len_t n = Rf_length(indices);
+  if (Rf_length(values) != n) {
+    Rf_errorcall(R_NilValue,
+                 "`indices` and `values` must have the same size, not %d and %d.",
+                 n, Rf_length(values));
+  }
+
+  if (x == R_NilValue) {
+    return R_NilValue;
+  }
+
+  vec_assert(x, opts->x_arg);
+
+  R_len_t size = vec_size(x);
+  SEXP names = PROTECT(vec_names(x));
+
+  SEXP proxy = vec_proxy(x);
+  PROTECT_INDEX proxy_pi;
+  PROTECT_WITH_INDEX(proxy, &proxy_pi);
+
+  enum vctrs_owned owned = vec_owned(proxy);
+
+  for (R_len_t i = 0; i < n; ++i) {
+    SEXP value = VECTOR_ELT(values, i);
+    vec_assert(value, opts->value_arg);
+
+    SEXP index = PROTECT(vec_as_location_compact(VECTOR_ELT(indices, i),
+                                                 size,
+                                                 names,
+                                                 location_default_assign_opts));
+
+    value = PROTECT(vec_cast(value, x, opts->value_arg, opts->x_arg));
+    value = PROTECT(vec_recycle(value, vec_subscript_size(index), opts->value_arg));
+
+    proxy = vec_proxy_assign_opts(proxy, index, value, owned, opts);
+    REPROTECT(proxy, proxy_pi);
+
+    // `proxy` is now either a fresh copy or was not referenced to begin with
+    owned = VCTRS_OWNED_true;
+
+    UNPROTECT(3);
+  }
+
+  SEXP out = vec_restore(proxy, x, R_NilValue, owned);
+
+  UNPROTECT(2);
+  return out;
+}
+
+// [[ register() ]]
+SEXP vctrs_assign_many(SEXP x, SEXP indices, SEXP values, SEXP x_arg_, SEXP value_arg_) {
+  struct vctrs_arg x_arg = vec_as_arg(x_arg_);
+  struct vctrs_arg value_arg = vec_as_arg(value_arg_);
+
+  const struct vec_assign_opts opts = {
+    .assign_names = false,
+    .x_arg = &x_arg,
+    .value_arg = &value_arg
+  };
+
+  return vec_assign_many_opts(x, indices, values, &opts);
+}
+
 static SEXP vec_assign_switch(SEXP proxy, SEXP index, SEXP value,
                               const enum vctrs_owned owned,
                               const struct vec_assign_opts* opts) {
@@ -225,6 +302,12 @@ SEXP vec_proxy_assign_opts(SEXP proxy, SEXP index, SEXP value,
   SEXP out = PROTECT(vec_clone_referenced(x, owned));                   \
   CTYPE* out_data = DEREF(out) + start;                                 \
                                                                         \
+  if (step == 1) {                                                      \
+    memmove(out_data, value_data, n * sizeof(CTYPE));                   \
+    UNPROTECT(1);                                                       \
+    return out;                                                         \
+  }                                                                     \
+                                                                        \
   for (int i = 0; i < n; ++i, out_data += step, ++value_data) {         \
     *out_data = *value_data;                                            \
   }                                                                     \
@@ -232,11 +315,38 @@ SEXP vec_proxy_assign_opts(SEXP proxy, SEXP index, SEXP value,
   UNPROTECT(1);                                                         \
   return out
 
-#define ASSIGN(CTYPE, DEREF, CONST_DEREF)       \
-  if (is_compact_seq(index)) {                  \
-    ASSIGN_COMPACT(CTYPE, DEREF, CONST_DEREF);  \
-  } else {                                      \
-    ASSIGN_INDEX(CTYPE, DEREF, CONST_DEREF);    \
+#define ASSIGN_COMPACT_RUNS(CTYPE, DEREF, CONST_DEREF)                  \
+  const int* index_data = INTEGER_RO(index);                            \
+  R_len_t n = index_data[0];                                            \
+  R_len_t n_runs = compact_runs_n(index);                               \
+                                                                        \
+  if (n != Rf_length(value)) {                                          \
+    r_stop_internal("vec_assign",                                       \
+                    "`value` should have been recycled to fit `x`.");   \
+  }                                                                     \
+                                                                        \
+  const CTYPE* value_data = CONST_DEREF(value);                         \
+                                                                        \
+  SEXP out = PROTECT(vec_clone_referenced(x, owned));                   \
+  CTYPE* out_data = DEREF(out);                                         \
+                                                                        \
+  for (R_len_t i = 0; i < n_runs; ++i) {                                \
+    R_len_t start = index_data[1 + 2 * i];                              \
+    R_len_t size = index_data[2 + 2 * i];                               \
+    memcpy(out_data + start, value_data, size * sizeof(CTYPE));         \
+    value_data += size;                                                 \
+  }                                                                     \
+                                                                        \
+  UNPROTECT(1);                                                         \
+  return out
+
+#define ASSIGN(CTYPE, DEREF, CONST_DEREF)            \
+  if (is_compact_seq(index)) {                       \
+    ASSIGN_COMPACT(CTYPE, DEREF, CONST_DEREF);       \
+  } else if (is_compact_runs(index)) {               \
+    ASSIGN_COMPACT_RUNS(CTYPE, DEREF, CONST_DEREF);  \
+  } else {                                           \
+    ASSIGN_INDEX(CTYPE, DEREF, CONST_DEREF);         \
   }
 
 static SEXP lgl_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned owned) {
@@ -251,9 +361,6 @@ static SEXP dbl_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned ow
 static SEXP cpl_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned owned) {
   ASSIGN(Rcomplex, COMPLEX, COMPLEX_RO);
 }
-SEXP chr_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned owned) {
-  ASSIGN(SEXP, STRING_PTR, STRING_PTR_RO);
-}
 static SEXP raw_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned owned) {
   ASSIGN(Rbyte, RAW, RAW_RO);
 }
@@ -261,6 +368,7 @@ static SEXP raw_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned ow
 #undef ASSIGN
 #undef ASSIGN_INDEX
 #undef ASSIGN_COMPACT
+#undef ASSIGN_COMPACT_RUNS
 
 
 #define ASSIGN_BARRIER_INDEX(GET, SET)                                  \
@@ -284,7 +392,9 @@ static SEXP raw_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned ow
   UNPROTECT(1);                                                         \
   return out
 
-#define ASSIGN_BARRIER_COMPACT(GET, SET)                                \
+// Contiguous ranges read `value` through its data pointer but still set
+// each element through the write barrier
+#define ASSIGN_BARRIER_COMPACT(GET, SET, CONST_DEREF)                   \
   int* index_data = INTEGER(index);                                     \
   R_len_t start = index_data[0];                                        \
   R_len_t n = index_data[1];                                            \
@@ -297,6 +407,15 @@ static SEXP raw_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned ow
                                                                         \
   SEXP out = PROTECT(vec_clone_referenced(x, owned));                   \
                                                                         \
+  if (step == 1) {                                                      \
+    const SEXP* value_data = CONST_DEREF(value);                        \
+    for (R_len_t i = 0; i < n; ++i) {                                   \
+      SET(out, start + i, value_data[i]);                               \
+    }                                                                   \
+    UNPROTECT(1);                                                       \
+    return out;                                                         \
+  }                                                                     \
+                                                                        \
   for (R_len_t i = 0; i < n; ++i, start += step) {                      \
     SET(out, start, GET(value, i));                                     \
   }                                                                     \
@@ -304,20 +423,50 @@ static SEXP raw_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned ow
   UNPROTECT(1);                                                         \
   return out
 
-#define ASSIGN_BARRIER(GET, SET)                \
-  if (is_compact_seq(index)) {                  \
-    ASSIGN_BARRIER_COMPACT(GET, SET);           \
-  } else {                                      \
-    ASSIGN_BARRIER_INDEX(GET, SET);             \
+#define ASSIGN_BARRIER_COMPACT_RUNS(GET, SET)                           \
+  const int* index_data = INTEGER_RO(index);                            \
+  R_len_t n = index_data[0];                                            \
+  R_len_t n_runs = compact_runs_n(index);                               \
+                                                                        \
+  if (n != Rf_length(value)) {                                          \
+    r_stop_internal("vec_assign",                                       \
+                    "`value` should have been recycled to fit `x`.");   \
+  }                                                                     \
+                                                                        \
+  SEXP out = PROTECT(vec_clone_referenced(x, owned));                   \
+  R_len_t k = 0;                                                        \
+                                                                        \
+  for (R_len_t i = 0; i < n_runs; ++i) {                                \
+    R_len_t start = index_data[1 + 2 * i];                              \
+    R_len_t size = index_data[2 + 2 * i];                               \
+    for (R_len_t j = 0; j < size; ++j, ++k) {                           \
+      SET(out, start + j, GET(value, k));                               \
+    }                                                                   \
+  }                                                                     \
+                                                                        \
+  UNPROTECT(1);                                                         \
+  return out
+
+#define ASSIGN_BARRIER(GET, SET, CONST_DEREF)          \
+  if (is_compact_seq(index)) {                         \
+    ASSIGN_BARRIER_COMPACT(GET, SET, CONST_DEREF);     \
+  } else if (is_compact_runs(index)) {                 \
+    ASSIGN_BARRIER_COMPACT_RUNS(GET, SET);             \
+  } else {                                             \
+    ASSIGN_BARRIER_INDEX(GET, SET);                    \
   }
 
+SEXP chr_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned owned) {
+  ASSIGN_BARRIER(STRING_ELT, SET_STRING_ELT, STRING_PTR_RO);
+}
 SEXP list_assign(SEXP x, SEXP index, SEXP value, const enum vctrs_owned owned) {
-  ASSIGN_BARRIER(VECTOR_ELT, SET_VECTOR_ELT);
+  ASSIGN_BARRIER(VECTOR_ELT, SET_VECTOR_ELT, VECTOR_PTR_RO);
 }
 
 #undef ASSIGN_BARRIER
 #undef ASSIGN_BARRIER_INDEX
 #undef ASSIGN_BARRIER_COMPACT
+#undef ASSIGN_BARRIER_COMPACT_RUNS
 
 
 /**
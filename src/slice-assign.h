@@ -12,6 +12,8 @@ struct vec_assign_opts {
 
 SEXP vec_assign_opts(SEXP x, SEXP index, SEXP value,
                      const struct vec_assign_opts* opts);
+SEXP vec_assign_many_opts(SEXP x, SEXP indices, SEXP values,
+                          const struct vec_assign_opts* opts);
 
 SEXP vec_proxy_assign_opts(SEXP proxy, SEXP index, SEXP value,
                            const enum vctrs_owned owned,
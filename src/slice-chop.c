@@ -1,10 +1,12 @@
 #include <rlang.h>
 #include "vctrs.h"
+#include "altrep-view.h"
 #include "dim.h"
 #include "slice.h"
 #include "subscript-loc.h"
 #include "type-data-frame.h"
 #include "owned.h"
+#include "parallel.h"
 #include "utils.h"
 
 /*
@@ -74,6 +76,7 @@ static struct vctrs_chop_info init_chop_info(SEXP x, SEXP indices) {
 static SEXP chop(SEXP x, SEXP indices, struct vctrs_chop_info info);
 static SEXP chop_shaped(SEXP x, SEXP indices, struct vctrs_chop_info info);
 static SEXP chop_df(SEXP x, SEXP indices, struct vctrs_chop_info info);
+static bool chop_df_parallel(SEXP proxy, SEXP indices, struct vctrs_chop_info info);
 static SEXP chop_fallback(SEXP x, SEXP indices, struct vctrs_chop_info info);
 static SEXP chop_fallback_shaped(SEXP x, SEXP indices, struct vctrs_chop_info info);
 
@@ -115,6 +118,59 @@ SEXP vctrs_chop(SEXP x, SEXP indices) {
   return out;
 }
 
+// [[ register() ]]
+SEXP vctrs_chop_order(SEXP x, SEXP order, SEXP sizes) {
+  if (TYPEOF(sizes) != INTSXP) {
+    Rf_errorcall(R_NilValue, "`sizes` must be an integer vector.");
+  }
+  return vec_chop_order(x, order, sizes);
+}
+
+/*
+ * Chops `x` into the groups of an ordering, as returned by
+ * `vec_order_info()`. The i-th group contains the elements of `x` at
+ * the next `sizes[i]` locations of `order`.
+ *
+ * Rather than one random access slice per group, `x` is permuted once
+ * into a contiguous buffer, which is then chopped with compact seqs.
+ * Large groups of bare integer and double vectors (or data frame
+ * columns) are returned as views into that buffer.
+ */
+// [[ include("vctrs.h") ]]
+SEXP vec_chop_order(SEXP x, SEXP order, SEXP sizes) {
+  const int* p_sizes = INTEGER_RO(sizes);
+  const R_len_t n_groups = Rf_length(sizes);
+  const R_len_t n = vec_size(order);
+
+  SEXP indices = PROTECT(Rf_allocVector(VECSXP, n_groups));
+
+  R_len_t start = 0;
+
+  for (R_len_t i = 0; i < n_groups; ++i) {
+    const int size = p_sizes[i];
+
+    if (size == NA_INTEGER || size < 0) {
+      Rf_errorcall(R_NilValue, "`sizes` can't contain missing or negative values.");
+    }
+    if (size > n - start) {
+      Rf_errorcall(R_NilValue, "`sizes` must sum to the size of `order`.");
+    }
+
+    SET_VECTOR_ELT(indices, i, compact_seq(start, size, true));
+    start += size;
+  }
+
+  if (start != n) {
+    Rf_errorcall(R_NilValue, "`sizes` must sum to the size of `order`.");
+  }
+
+  SEXP sorted = PROTECT(vec_slice(x, order));
+  SEXP out = vec_chop(sorted, indices);
+
+  UNPROTECT(2);
+  return out;
+}
+
 // [[ include("vctrs.h") ]]
 SEXP vec_chop(SEXP x, SEXP indices) {
   int nprot = 0;
@@ -178,10 +234,28 @@ static SEXP vec_chop_base(SEXP x, SEXP indices, struct vctrs_chop_info info) {
   }
 }
 
+static inline bool is_contiguous_compact_seq(SEXP index) {
+  if (!is_compact_seq(index)) {
+    return false;
+  }
+
+  const int* p_index = INTEGER_RO(index);
+  return p_index[2] == 1 && p_index[1] >= ALTREP_VIEW_MIN_SIZE;
+}
+
 static SEXP chop(SEXP x, SEXP indices, struct vctrs_chop_info info) {
   SEXP proxy = info.proxy_info.proxy;
   SEXP names = PROTECT(Rf_getAttrib(proxy, R_NamesSymbol));
 
+  // Large contiguous slices of bare vectors are views into `proxy`
+  // rather than copies. They don't need restoring.
+  // Views skip `vec_restore()`, so they are only used when `x` is bare
+  // and its proxy is `x` itself
+  bool use_views =
+    info.has_indices &&
+    ATTRIB(x) == R_NilValue &&
+    altrep_view_supports(proxy);
+
   for (R_len_t i = 0; i < info.out_size; ++i) {
     if (info.has_indices) {
       info.index = VECTOR_ELT(indices, i);
@@ -190,6 +264,12 @@ static SEXP chop(SEXP x, SEXP indices, struct vctrs_chop_info info) {
       ++(*info.p_index);
     }
 
+    if (use_views && is_contiguous_compact_seq(info.index)) {
+      const int* p_index = INTEGER_RO(info.index);
+      SET_VECTOR_ELT(info.out, i, altrep_view_make(proxy, p_index[0], p_index[1]));
+      continue;
+    }
+
     SEXP elt = PROTECT(vec_slice_base(info.proxy_info.type, proxy, info.index));
 
     if (names != R_NilValue) {
@@ -240,16 +320,18 @@ static SEXP chop_df(SEXP x, SEXP indices, struct vctrs_chop_info info) {
 
   // Split each column according to the indices, and then assign the results
   // into the appropriate data frame column in the `out` list
-  for (int i = 0; i < n_cols; ++i) {
-    SEXP col = VECTOR_ELT(proxy, i);
-    SEXP split = PROTECT(vec_chop(col, indices));
+  if (!chop_df_parallel(proxy, indices, info)) {
+    for (int i = 0; i < n_cols; ++i) {
+      SEXP col = VECTOR_ELT(proxy, i);
+      SEXP split = PROTECT(vec_chop(col, indices));
+
+      for (int j = 0; j < info.out_size; ++j) {
+        SEXP elt = VECTOR_ELT(info.out, j);
+        SET_VECTOR_ELT(elt, i, VECTOR_ELT(split, j));
+      }
 
-    for (int j = 0; j < info.out_size; ++j) {
-      SEXP elt = VECTOR_ELT(info.out, j);
-      SET_VECTOR_ELT(elt, i, VECTOR_ELT(split, j));
+      UNPROTECT(1);
     }
-
-    UNPROTECT(1);
   }
 
   // Restore each data frame
@@ -267,6 +349,275 @@ static SEXP chop_df(SEXP x, SEXP indices, struct vctrs_chop_info info) {
   return info.out;
 }
 
+// -----------------------------------------------------------------------------
+
+#define CHOP_DF_PARALLEL_THRESHOLD 100000
+
+/*
+ * An index of `vec_chop()` in a form that worker threads can read
+ * without touching the R API.
+ *
+ * @member p_loc The 1-based locations of a materialized index, or `NULL`
+ *   for compact indices.
+ * @member start,step The 0-based start and the step of a compact index.
+ *   Compact reps have a step of 0.
+ * @member size The size of the index.
+ * @member na Whether a compact rep repeats a missing location.
+ */
+struct chop_gather_index {
+  const int* p_loc;
+  R_len_t start;
+  R_len_t step;
+  R_len_t size;
+  bool na;
+};
+
+/*
+ * A single column chunk to fill on a worker thread.
+ * `p_col` and `p_out` are taken on the main thread.
+ */
+struct chop_gather_piece {
+  enum vctrs_type type;
+  const void* p_col;
+  void* p_out;
+  const struct chop_gather_index* p_index;
+};
+
+static bool chop_gather_index_init(struct chop_gather_index* p_index, SEXP index) {
+  if (is_compact_seq(index)) {
+    const int* p = INTEGER_RO(index);
+    *p_index = (struct chop_gather_index) {
+      .p_loc = NULL, .start = p[0], .step = p[2], .size = p[1], .na = false
+    };
+    return true;
+  }
+
+  if (is_compact_rep(index)) {
+    const int* p = INTEGER_RO(index);
+    const bool na = p[0] == NA_INTEGER;
+    *p_index = (struct chop_gather_index) {
+      .p_loc = NULL, .start = na ? 0 : p[0] - 1, .step = 0, .size = p[1], .na = na
+    };
+    return true;
+  }
+
+  if (TYPEOF(index) == INTSXP && !is_compact_runs(index)) {
+    *p_index = (struct chop_gather_index) {
+      .p_loc = INTEGER_RO(index), .start = 0, .step = 0, .size = Rf_length(index), .na = false
+    };
+    return true;
+  }
+
+  return false;
+}
+
+// Columns of atomic types that can be sliced by copying memory.
+// Character columns are excluded because `SET_STRING_ELT()` isn't
+// thread safe.
+static bool chop_df_col_gatherable(SEXP col, struct vctrs_proxy_info info) {
+  if (vec_requires_fallback(col, info) || has_dim(col)) {
+    return false;
+  }
+
+  switch (info.type) {
+  case vctrs_type_logical:
+  case vctrs_type_integer:
+  case vctrs_type_double:
+  case vctrs_type_complex:
+  case vctrs_type_raw:
+    break;
+  default:
+    return false;
+  }
+
+  return !ALTREP(info.proxy) && Rf_getAttrib(info.proxy, R_NamesSymbol) == R_NilValue;
+}
+
+static const void* chop_gather_const_deref(SEXP x, enum vctrs_type type) {
+  switch (type) {
+  case vctrs_type_logical: return LOGICAL_RO(x);
+  case vctrs_type_integer: return INTEGER_RO(x);
+  case vctrs_type_double: return REAL_RO(x);
+  case vctrs_type_complex: return COMPLEX_RO(x);
+  case vctrs_type_raw: return RAW_RO(x);
+  default: stop_unimplemented_vctrs_type("chop_gather_const_deref", type);
+  }
+}
+
+static void* chop_gather_deref(SEXP x, enum vctrs_type type) {
+  switch (type) {
+  case vctrs_type_logical: return LOGICAL(x);
+  case vctrs_type_integer: return INTEGER(x);
+  case vctrs_type_double: return REAL(x);
+  case vctrs_type_complex: return COMPLEX(x);
+  case vctrs_type_raw: return RAW(x);
+  default: stop_unimplemented_vctrs_type("chop_gather_deref", type);
+  }
+}
+
+#define CHOP_GATHER(CTYPE, NA_VALUE)                                    \
+  do {                                                                  \
+    const CTYPE* p_col = (const CTYPE*) piece.p_col;                    \
+    CTYPE* p_out = (CTYPE*) piece.p_out;                                \
+    const struct chop_gather_index index = *piece.p_index;              \
+                                                                        \
+    if (index.p_loc != NULL) {                                          \
+      for (R_len_t i = 0; i < index.size; ++i) {                        \
+        const int loc = index.p_loc[i];                                 \
+        p_out[i] = (loc == NA_INTEGER) ? NA_VALUE : p_col[loc - 1];     \
+      }                                                                 \
+    } else if (index.na) {                                              \
+      for (R_len_t i = 0; i < index.size; ++i) {                        \
+        p_out[i] = NA_VALUE;                                            \
+      }                                                                 \
+    } else {                                                            \
+      p_col += index.start;                                             \
+      for (R_len_t i = 0; i < index.size; ++i, p_col += index.step) {   \
+        p_out[i] = *p_col;                                              \
+      }                                                                 \
+    }                                                                   \
+  } while (0)
+
+// Runs on worker threads. Must not call the R API.
+static void chop_gather(struct chop_gather_piece piece) {
+  switch (piece.type) {
+  case vctrs_type_logical: CHOP_GATHER(int, NA_LOGICAL); break;
+  case vctrs_type_integer: CHOP_GATHER(int, NA_INTEGER); break;
+  case vctrs_type_double: CHOP_GATHER(double, NA_REAL); break;
+  case vctrs_type_complex: CHOP_GATHER(Rcomplex, vctrs_shared_na_cpl); break;
+  case vctrs_type_raw: CHOP_GATHER(Rbyte, 0); break;
+  default: break;
+  }
+}
+
+#undef CHOP_GATHER
+
+/*
+ * Chops the columns of `proxy` into the data frames preloaded in
+ * `info.out`, gathering atomic columns on worker threads. Each column
+ * chunk is allocated on the main thread, then filled in parallel, and
+ * finally restored on the main thread. Other columns are chopped with
+ * `vec_chop()` as usual.
+ *
+ * Returns `false` without doing anything if the chop is too small to be
+ * worth splitting across threads, or if `indices` contains subscripts
+ * other than integer locations and compact seqs or reps.
+ */
+static bool chop_df_parallel(SEXP proxy, SEXP indices, struct vctrs_chop_info info) {
+  if (!info.has_indices) {
+    return false;
+  }
+
+  const int n_cols = Rf_length(proxy);
+  const R_len_t n_indices = info.out_size;
+
+  struct chop_gather_index* v_indices =
+    (struct chop_gather_index*) R_alloc(n_indices, sizeof(struct chop_gather_index));
+
+  r_ssize size = 0;
+
+  for (R_len_t i = 0; i < n_indices; ++i) {
+    if (!chop_gather_index_init(&v_indices[i], VECTOR_ELT(indices, i))) {
+      return false;
+    }
+    size += v_indices[i].size;
+  }
+
+  const int n_threads = vec_n_threads(size * n_cols, CHOP_DF_PARALLEL_THRESHOLD);
+  if (n_threads == 1) {
+    return false;
+  }
+
+  int nprot = 0;
+
+  // Keeps proxies alive until their chunks are gathered
+  SEXP proxies = PROTECT_N(Rf_allocVector(VECSXP, n_cols), &nprot);
+  bool* v_gatherable = (bool*) R_alloc(n_cols, sizeof(bool));
+
+  struct chop_gather_piece* v_pieces = NULL;
+  r_ssize n_pieces = 0;
+
+  for (int i = 0; i < n_cols; ++i) {
+    SEXP col = VECTOR_ELT(proxy, i);
+
+    struct vctrs_proxy_info col_info = vec_proxy_info(col);
+    SET_VECTOR_ELT(proxies, i, col_info.proxy);
+
+    v_gatherable[i] = chop_df_col_gatherable(col, col_info);
+
+    if (!v_gatherable[i]) {
+      SEXP split = PROTECT(vec_chop(col, indices));
+
+      for (R_len_t j = 0; j < n_indices; ++j) {
+        SEXP elt = VECTOR_ELT(info.out, j);
+        SET_VECTOR_ELT(elt, i, VECTOR_ELT(split, j));
+      }
+
+      UNPROTECT(1);
+      continue;
+    }
+
+    if (v_pieces == NULL) {
+      v_pieces = (struct chop_gather_piece*) R_alloc(
+        (r_ssize) n_cols * n_indices,
+        sizeof(struct chop_gather_piece)
+      );
+    }
+
+    SEXP col_proxy = col_info.proxy;
+    const void* p_col = chop_gather_const_deref(col_proxy, col_info.type);
+    const SEXPTYPE col_type = TYPEOF(col_proxy);
+    const bool use_views = altrep_view_supports(col_proxy);
+
+    for (R_len_t j = 0; j < n_indices; ++j) {
+      SEXP elt = VECTOR_ELT(info.out, j);
+      SEXP index = VECTOR_ELT(indices, j);
+
+      if (use_views && is_contiguous_compact_seq(index)) {
+        const int* p_index = INTEGER_RO(index);
+        SET_VECTOR_ELT(elt, i, altrep_view_make(col_proxy, p_index[0], p_index[1]));
+        continue;
+      }
+
+      SEXP chunk = Rf_allocVector(col_type, v_indices[j].size);
+      SET_VECTOR_ELT(elt, i, chunk);
+
+      v_pieces[n_pieces++] = (struct chop_gather_piece) {
+        .type = col_info.type,
+        .p_col = p_col,
+        .p_out = chop_gather_deref(chunk, col_info.type),
+        .p_index = &v_indices[j]
+      };
+    }
+  }
+
+  VCTRS_OMP_PARALLEL_FOR_DYNAMIC(n_threads)
+  for (r_ssize k = 0; k < n_pieces; ++k) {
+    chop_gather(v_pieces[k]);
+  }
+
+  // Restore chunks of gathered columns that have attributes, e.g. dates
+  for (int i = 0; i < n_cols; ++i) {
+    SEXP col = VECTOR_ELT(proxy, i);
+
+    if (!v_gatherable[i] || ATTRIB(col) == R_NilValue) {
+      continue;
+    }
+
+    for (R_len_t j = 0; j < n_indices; ++j) {
+      *info.p_restore_size = v_indices[j].size;
+
+      SEXP elt = VECTOR_ELT(info.out, j);
+      SEXP chunk = VECTOR_ELT(elt, i);
+      chunk = vec_restore(chunk, col, info.restore_size, vec_owned(chunk));
+      SET_VECTOR_ELT(elt, i, chunk);
+    }
+  }
+
+  UNPROTECT(nprot);
+  return true;
+}
+
 static SEXP chop_shaped(SEXP x, SEXP indices, struct vctrs_chop_info info) {
   SEXP proxy = info.proxy_info.proxy;
   SEXP dim_names = PROTECT(Rf_getAttrib(proxy, R_DimNamesSymbol));
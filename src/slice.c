@@ -5,6 +5,7 @@
 #include "subscript-loc.h"
 #include "type-data-frame.h"
 #include "owned.h"
+#include "parallel.h"
 #include "utils.h"
 #include "dim.h"
 
@@ -18,20 +19,141 @@ SEXP syms_vec_slice_dispatch_integer64 = NULL;
 SEXP fns_vec_slice_dispatch_integer64 = NULL;
 
 
-#define SLICE_SUBSCRIPT(RTYPE, CTYPE, DEREF, CONST_DEREF, NA_VALUE)     \
-  const CTYPE* data = CONST_DEREF(x);                                   \
-  R_len_t n = Rf_length(subscript);                                     \
-  int* subscript_data = INTEGER(subscript);                             \
-                                                                        \
-  SEXP out = PROTECT(Rf_allocVector(RTYPE, n));                         \
-  CTYPE* out_data = DEREF(out);                                         \
-                                                                        \
-  for (R_len_t i = 0; i < n; ++i, ++subscript_data, ++out_data) {       \
-    int j = *subscript_data;                                            \
-    *out_data = (j == NA_INTEGER) ? NA_VALUE : data[j - 1];             \
-  }                                                                     \
-                                                                        \
-  UNPROTECT(1);                                                         \
+/*
+ * Subscripts are gathered in blocks of `SLICE_BLOCK_SIZE` locations.
+ * Blocks without missing locations, the common case for locations
+ * coming from `vec_order()` or `vec_match()`, are copied without a
+ * branch per element. When `x` is too large to stay in cache, the
+ * locations `SLICE_PREFETCH_DISTANCE` elements ahead are prefetched.
+ */
+#define SLICE_BLOCK_SIZE 8
+#define SLICE_PREFETCH_DISTANCE 64
+#define SLICE_PREFETCH_MIN_BYTES (1 << 20)
+#define SLICE_PARALLEL_THRESHOLD 100000
+#define SLICE_RUN_MIN_SIZE 8
+
+#if defined(__GNUC__) || defined(__clang__)
+# define SLICE_PREFETCH(ADDR) __builtin_prefetch(ADDR)
+#else
+# define SLICE_PREFETCH(ADDR) ((void) (ADDR))
+#endif
+
+// Size of the subscript range gathered by each of `n_threads` threads,
+// rounded up to whole blocks
+static inline R_len_t slice_chunk_size(R_len_t n, int n_threads) {
+  R_len_t size = n / n_threads + 1;
+  return size + (SLICE_BLOCK_SIZE - size % SLICE_BLOCK_SIZE) % SLICE_BLOCK_SIZE;
+}
+
+/*
+ * Subscripts made of increasing runs of consecutive locations, such as
+ * filters from `which()`, are copied run by run with `memcpy()`. Runs of
+ * missing locations are filled with `NA_VALUE`. Copying stops as soon as
+ * runs get shorter than `SLICE_RUN_MIN_SIZE` on average, and the rest of
+ * the range is gathered block by block. Random subscripts give up after
+ * a handful of locations.
+ */
+#define SLICE_SUBSCRIPT_RUNS(CTYPE, NA_VALUE, I, TO)                          \
+  do {                                                                        \
+    const R_len_t runs_from = I;                                              \
+    R_len_t n_runs = 0;                                                       \
+                                                                              \
+    while (I < TO) {                                                          \
+      if (n_runs > 4 && n_runs * SLICE_RUN_MIN_SIZE > I - runs_from) {        \
+        break;                                                                \
+      }                                                                       \
+                                                                              \
+      const int start = subscript_data[I];                                    \
+      R_len_t k = I + 1;                                                      \
+                                                                              \
+      if (start == NA_INTEGER) {                                              \
+        out_data[I] = NA_VALUE;                                               \
+        for (; k < TO && subscript_data[k] == NA_INTEGER; ++k) {              \
+          out_data[k] = NA_VALUE;                                             \
+        }                                                                     \
+      } else {                                                                \
+        const R_xlen_t offset = (R_xlen_t) start - I;                         \
+        while (k < TO && subscript_data[k] == offset + k) {                   \
+          ++k;                                                                \
+        }                                                                     \
+        memcpy(out_data + I, data + start - 1, (k - I) * sizeof(CTYPE));      \
+      }                                                                       \
+                                                                              \
+      ++n_runs;                                                               \
+      I = k;                                                                  \
+    }                                                                         \
+  } while (0)
+
+#define SLICE_SUBSCRIPT_RANGE(CTYPE, NA_VALUE, FROM, TO)                     \
+  do {                                                                        \
+    const R_len_t slice_to = TO;                                              \
+    R_len_t i = FROM;                                                         \
+    SLICE_SUBSCRIPT_RUNS(CTYPE, NA_VALUE, i, slice_to);                       \
+    const R_len_t slice_to_blocked = slice_to - (slice_to - i) % SLICE_BLOCK_SIZE; \
+                                                                              \
+    for (; i < slice_to_blocked; i += SLICE_BLOCK_SIZE) {                     \
+      const int* locs = subscript_data + i;                                   \
+                                                                              \
+      if (prefetch && i + SLICE_PREFETCH_DISTANCE < slice_to_blocked) {       \
+        const int* ahead = locs + SLICE_PREFETCH_DISTANCE;                    \
+        for (int k = 0; k < SLICE_BLOCK_SIZE; ++k) {                          \
+          const int j = ahead[k];                                             \
+          SLICE_PREFETCH(data + (j == NA_INTEGER ? 0 : j - 1));               \
+        }                                                                     \
+      }                                                                       \
+                                                                              \
+      bool any_na = false;                                                    \
+      for (int k = 0; k < SLICE_BLOCK_SIZE; ++k) {                            \
+        any_na |= locs[k] == NA_INTEGER;                                      \
+      }                                                                       \
+                                                                              \
+      if (any_na) {                                                           \
+        for (int k = 0; k < SLICE_BLOCK_SIZE; ++k) {                          \
+          const int j = locs[k];                                              \
+          out_data[i + k] = (j == NA_INTEGER) ? NA_VALUE : data[j - 1];       \
+        }                                                                     \
+      } else {                                                                \
+        for (int k = 0; k < SLICE_BLOCK_SIZE; ++k) {                          \
+          out_data[i + k] = data[locs[k] - 1];                                \
+        }                                                                     \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    for (; i < slice_to; ++i) {                                               \
+      const int j = subscript_data[i];                                        \
+      out_data[i] = (j == NA_INTEGER) ? NA_VALUE : data[j - 1];               \
+    }                                                                         \
+  } while (0)
+
+// Large subscripts are split in ranges of whole blocks, one per thread
+#define SLICE_SUBSCRIPT(RTYPE, CTYPE, DEREF, CONST_DEREF, NA_VALUE)       \
+  const CTYPE* data = CONST_DEREF(x);                                     \
+  R_len_t n = Rf_length(subscript);                                       \
+  const int* subscript_data = INTEGER_RO(subscript);                      \
+                                                                          \
+  SEXP out = PROTECT(Rf_allocVector(RTYPE, n));                           \
+  CTYPE* out_data = DEREF(out);                                           \
+                                                                          \
+  const bool prefetch =                                                   \
+    (size_t) Rf_xlength(x) * sizeof(CTYPE) >= SLICE_PREFETCH_MIN_BYTES;   \
+                                                                          \
+  const int n_threads = vec_n_threads(n, SLICE_PARALLEL_THRESHOLD);       \
+                                                                          \
+  if (n_threads == 1) {                                                   \
+    SLICE_SUBSCRIPT_RANGE(CTYPE, NA_VALUE, 0, n);                         \
+  } else {                                                                \
+    const R_len_t chunk_size = slice_chunk_size(n, n_threads);            \
+    const R_len_t n_chunks = (n + chunk_size - 1) / chunk_size;           \
+                                                                          \
+    VCTRS_OMP_PARALLEL_FOR(n_threads)                                     \
+    for (R_len_t chunk = 0; chunk < n_chunks; ++chunk) {                  \
+      const R_len_t from = chunk * chunk_size;                            \
+      const R_len_t to = (n - from < chunk_size) ? n : from + chunk_size; \
+      SLICE_SUBSCRIPT_RANGE(CTYPE, NA_VALUE, from, to);                   \
+    }                                                                     \
+  }                                                                       \
+                                                                          \
+  UNPROTECT(1);                                                           \
   return out
 
 #define SLICE_COMPACT_REP(RTYPE, CTYPE, DEREF, CONST_DEREF, NA_VALUE)   \
@@ -64,6 +186,12 @@ SEXP fns_vec_slice_dispatch_integer64 = NULL;
   SEXP out = PROTECT(Rf_allocVector(RTYPE, n));                 \
   CTYPE* out_data = DEREF(out);                                 \
                                                                 \
+  if (step == 1) {                                              \
+    memcpy(out_data, data, n * sizeof(CTYPE));                  \
+    UNPROTECT(1);                                               \
+    return out;                                                 \
+  }                                                             \
+                                                                \
   for (int i = 0; i < n; ++i, ++out_data, data += step) {       \
     *out_data = *data;                                          \
   }                                                             \
@@ -71,6 +199,26 @@ SEXP fns_vec_slice_dispatch_integer64 = NULL;
   UNPROTECT(1);                                                 \
   return out
 
+#define SLICE_COMPACT_RUNS(RTYPE, CTYPE, DEREF, CONST_DEREF)    \
+  const int* subscript_data = INTEGER_RO(subscript);            \
+  R_len_t n = subscript_data[0];                                \
+  R_len_t n_runs = compact_runs_n(subscript);                   \
+                                                                \
+  const CTYPE* data = CONST_DEREF(x);                           \
+                                                                \
+  SEXP out = PROTECT(Rf_allocVector(RTYPE, n));                 \
+  CTYPE* out_data = DEREF(out);                                 \
+                                                                \
+  for (R_len_t i = 0; i < n_runs; ++i) {                        \
+    R_len_t start = subscript_data[1 + 2 * i];                  \
+    R_len_t size = subscript_data[2 + 2 * i];                   \
+    memcpy(out_data, data + start, size * sizeof(CTYPE));       \
+    out_data += size;                                           \
+  }                                                             \
+                                                                \
+  UNPROTECT(1);                                                 \
+  return out
+
 #define SLICE(RTYPE, CTYPE, DEREF, CONST_DEREF, NA_VALUE)                   \
   if (ALTREP(x)) {                                                          \
     SEXP alt_subscript = PROTECT(compact_materialize(subscript));           \
@@ -84,6 +232,8 @@ SEXP fns_vec_slice_dispatch_integer64 = NULL;
     SLICE_COMPACT_REP(RTYPE, CTYPE, DEREF, CONST_DEREF, NA_VALUE);          \
   } else if (is_compact_seq(subscript)) {                                   \
     SLICE_COMPACT_SEQ(RTYPE, CTYPE, DEREF, CONST_DEREF);                    \
+  } else if (is_compact_runs(subscript)) {                                  \
+    SLICE_COMPACT_RUNS(RTYPE, CTYPE, DEREF, CONST_DEREF);                   \
   } else {                                                                  \
     SLICE_SUBSCRIPT(RTYPE, CTYPE, DEREF, CONST_DEREF, NA_VALUE);            \
   }
@@ -110,8 +260,13 @@ static SEXP raw_slice(SEXP x, SEXP subscript) {
 #undef SLICE
 #undef SLICE_COMPACT_REP
 #undef SLICE_COMPACT_SEQ
+#undef SLICE_COMPACT_RUNS
 #undef SLICE_SUBSCRIPT
+#undef SLICE_SUBSCRIPT_RANGE
+#undef SLICE_SUBSCRIPT_RUNS
 
+// Lists are sliced serially. Their elements must be set through the
+// write barrier, which would dominate a parallel gather.
 #define SLICE_BARRIER_SUBSCRIPT(RTYPE, CTYPE, CONST_DEREF, SET, NA_VALUE)  \
   const CTYPE* data = CONST_DEREF(x);                                      \
                                                                            \
@@ -158,6 +313,15 @@ static SEXP raw_slice(SEXP x, SEXP subscript) {
                                                                    \
   SEXP out = PROTECT(Rf_allocVector(RTYPE, n));                    \
                                                                    \
+  if (step == 1) {                                                 \
+    data += start;                                                 \
+    for (R_len_t i = 0; i < n; ++i) {                              \
+      SET(out, i, data[i]);                                        \
+    }                                                              \
+    UNPROTECT(1);                                                  \
+    return out;                                                    \
+  }                                                                \
+                                                                   \
   for (R_len_t i = 0; i < n; ++i, start += step) {                 \
     SET(out, i, data[start]);                                      \
   }                                                                \
@@ -165,11 +329,34 @@ static SEXP raw_slice(SEXP x, SEXP subscript) {
   UNPROTECT(1);                                                    \
   return out
 
+#define SLICE_BARRIER_COMPACT_RUNS(RTYPE, CTYPE, CONST_DEREF, SET) \
+  const CTYPE* data = CONST_DEREF(x);                              \
+                                                                   \
+  const int* subscript_data = INTEGER_RO(subscript);               \
+  R_len_t n = subscript_data[0];                                   \
+  R_len_t n_runs = compact_runs_n(subscript);                      \
+                                                                   \
+  SEXP out = PROTECT(Rf_allocVector(RTYPE, n));                    \
+  R_len_t k = 0;                                                   \
+                                                                   \
+  for (R_len_t i = 0; i < n_runs; ++i) {                           \
+    R_len_t start = subscript_data[1 + 2 * i];                     \
+    R_len_t size = subscript_data[2 + 2 * i];                      \
+    for (R_len_t j = 0; j < size; ++j, ++k) {                      \
+      SET(out, k, data[start + j]);                                \
+    }                                                              \
+  }                                                                \
+                                                                   \
+  UNPROTECT(1);                                                    \
+  return out
+
 #define SLICE_BARRIER(RTYPE, CTYPE, CONST_DEREF, SET, NA_VALUE)          \
   if (is_compact_rep(subscript)) {                                       \
     SLICE_BARRIER_COMPACT_REP(RTYPE, CTYPE, CONST_DEREF, SET, NA_VALUE); \
   } else if (is_compact_seq(subscript)) {                                \
     SLICE_BARRIER_COMPACT_SEQ(RTYPE, CTYPE, CONST_DEREF, SET);           \
+  } else if (is_compact_runs(subscript)) {                               \
+    SLICE_BARRIER_COMPACT_RUNS(RTYPE, CTYPE, CONST_DEREF, SET);          \
   } else {                                                               \
     SLICE_BARRIER_SUBSCRIPT(RTYPE, CTYPE, CONST_DEREF, SET, NA_VALUE);   \
   }
@@ -181,6 +368,7 @@ static SEXP list_slice(SEXP x, SEXP subscript) {
 #undef SLICE_BARRIER
 #undef SLICE_BARRIER_COMPACT_REP
 #undef SLICE_BARRIER_COMPACT_SEQ
+#undef SLICE_BARRIER_COMPACT_RUNS
 #undef SLICE_BARRIER_SUBSCRIPT
 
 static SEXP df_slice(SEXP x, SEXP subscript) {
@@ -274,8 +462,8 @@ static void repair_na_names(SEXP names, SEXP subscript) {
     r_stop_internal("repair_na_names", "`names` can't be referenced.");
   }
 
-  // No possible way to have `NA_integer_` in a compact seq
-  if (is_compact_seq(subscript)) {
+  // No possible way to have `NA_integer_` in a compact seq or runs
+  if (is_compact_seq(subscript) || is_compact_runs(subscript)) {
     return;
   }
 
@@ -454,7 +642,10 @@ bool vec_is_restored(SEXP x, SEXP to) {
 SEXP vec_slice(SEXP x, SEXP subscript) {
   vec_assert(x, args_empty);
 
-  subscript = PROTECT(vec_as_location(subscript, vec_size(x), PROTECT(vec_names(x))));
+  subscript = PROTECT(vec_as_location_compact(subscript,
+                                              vec_size(x),
+                                              PROTECT(vec_names(x)),
+                                              location_default_opts));
   SEXP out = vec_slice_impl(x, subscript);
 
   UNPROTECT(2);
@@ -473,6 +664,66 @@ SEXP vec_init(SEXP x, R_len_t n) {
   return out;
 }
 
+/*
+ * Like `vec_init()`, but for callers that are about to overwrite every
+ * element of the output, like `vec_c()`. Bare atomic vectors are allocated
+ * without writing missing values first. Character vectors and lists are
+ * filled by R with empty strings and `NULL` since the GC needs valid
+ * contents, which is still cheaper than slicing with missing locations.
+ * Data frames are supported when all their columns are.
+ *
+ * Returns `NULL` for other types, in which case `vec_init()` should be used.
+ */
+// [[ include("vctrs.h") ]]
+SEXP vec_init_uninitialized(SEXP x, R_len_t n) {
+  if (ATTRIB(x) == R_NilValue) {
+    switch (TYPEOF(x)) {
+    case LGLSXP:
+    case INTSXP:
+    case REALSXP:
+    case CPLXSXP:
+    case RAWSXP:
+    case STRSXP:
+    case VECSXP:
+      return Rf_allocVector(TYPEOF(x), n);
+    default:
+      return R_NilValue;
+    }
+  }
+
+  switch (class_type(x)) {
+  case vctrs_class_bare_data_frame:
+  case vctrs_class_bare_tibble:
+    break;
+  default:
+    return R_NilValue;
+  }
+
+  if (rownames_type(df_rownames(x)) == ROWNAMES_IDENTIFIERS) {
+    return R_NilValue;
+  }
+
+  R_len_t n_cols = Rf_length(x);
+  SEXP out = PROTECT(Rf_allocVector(VECSXP, n_cols));
+
+  for (R_len_t i = 0; i < n_cols; ++i) {
+    SEXP col = vec_init_uninitialized(VECTOR_ELT(x, i), n);
+
+    if (col == R_NilValue) {
+      UNPROTECT(1);
+      return R_NilValue;
+    }
+
+    SET_VECTOR_ELT(out, i, col);
+  }
+
+  SHALLOW_DUPLICATE_ATTRIB(out, x);
+  init_compact_rownames(out, n);
+
+  UNPROTECT(1);
+  return out;
+}
+
 // [[ register() ]]
 SEXP vctrs_init(SEXP x, SEXP n) {
   R_len_t n_ = r_int_get(n, 0);
@@ -309,6 +309,90 @@ SEXP vec_as_location(SEXP subscript, R_len_t n, SEXP names) {
                               location_default_opts);
 }
 
+#define COMPACT_RUNS_MIN_SIZE 1024
+#define COMPACT_RUNS_MIN_RUN_SIZE 8
+
+/*
+ * Converts a bare logical subscript of size `n` into compact runs of
+ * the selected locations, without materializing them as an integer
+ * vector. Returns `NULL` if the subscript is small, contains missing
+ * values, or if its runs are shorter than `COMPACT_RUNS_MIN_RUN_SIZE` on
+ * average, in which case a regular vector of locations is better.
+ */
+static SEXP lgl_as_compact_runs(SEXP subscript, R_len_t n) {
+  if (TYPEOF(subscript) != LGLSXP ||
+      ATTRIB(subscript) != R_NilValue ||
+      Rf_length(subscript) != n ||
+      n < COMPACT_RUNS_MIN_SIZE) {
+    return R_NilValue;
+  }
+
+  const int* p_subscript = LOGICAL_RO(subscript);
+
+  R_len_t n_runs = 0;
+  R_len_t n_selected = 0;
+  int prev = 0;
+
+  for (R_len_t i = 0; i < n; ++i) {
+    const int elt = p_subscript[i];
+
+    if (elt == NA_LOGICAL) {
+      return R_NilValue;
+    }
+
+    n_runs += elt && !prev;
+    n_selected += elt;
+    prev = elt;
+  }
+
+  if ((r_ssize) n_runs * COMPACT_RUNS_MIN_RUN_SIZE > n_selected) {
+    return R_NilValue;
+  }
+
+  SEXP out = PROTECT(compact_runs(n_runs));
+  int* p_out = INTEGER(out);
+
+  R_len_t run = 0;
+  R_len_t i = 0;
+
+  while (i < n) {
+    if (!p_subscript[i]) {
+      ++i;
+      continue;
+    }
+
+    R_len_t start = i;
+    while (i < n && p_subscript[i]) {
+      ++i;
+    }
+
+    init_compact_runs(p_out, run, start, i - start);
+    ++run;
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+/*
+ * Like `vec_as_location_opts()`, but large logical subscripts made of
+ * long runs are returned as compact runs. Only for callers that pass the
+ * result straight to `vec_slice_impl()` or `vec_proxy_assign_opts()`.
+ */
+// [[ include("subscript-loc.h") ]]
+SEXP vec_as_location_compact(SEXP subscript, R_len_t n, SEXP names,
+                             const struct location_opts* opts) {
+  if (opts->subscript_opts->logical == SUBSCRIPT_TYPE_ACTION_CAST) {
+    SEXP out = lgl_as_compact_runs(subscript, n);
+
+    if (out != R_NilValue) {
+      return out;
+    }
+  }
+
+  return vec_as_location_opts(subscript, n, names, opts);
+}
+
 SEXP vec_as_location_opts(SEXP subscript, R_len_t n, SEXP names,
                           const struct location_opts* opts) {
 
@@ -42,6 +42,8 @@ static const struct location_opts* const location_default_assign_opts = &locatio
 SEXP vec_as_location(SEXP i, R_len_t n, SEXP names);
 SEXP vec_as_location_opts(SEXP subscript, R_len_t n, SEXP names,
                           const struct location_opts* location_opts);
+SEXP vec_as_location_compact(SEXP subscript, R_len_t n, SEXP names,
+                             const struct location_opts* opts);
 
 
 #endif
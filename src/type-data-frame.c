@@ -728,7 +728,8 @@ static SEXP df_cast_match(const struct cast_opts* opts,
         .to = VECTOR_ELT(to, i),
         .x_arg = &named_x_arg,
         .to_arg = &named_to_arg,
-        .fallback = opts->fallback
+        .fallback = opts->fallback,
+        .p_fct_cache = opts->p_fct_cache
       };
       col = vec_cast_opts(&col_opts);
     }
@@ -777,7 +778,8 @@ static SEXP df_cast_loop(const struct cast_opts* opts, SEXP names) {
       .to = VECTOR_ELT(to, i),
       .x_arg = &named_x_arg,
       .to_arg = &named_to_arg,
-      .fallback = opts->fallback
+      .fallback = opts->fallback,
+      .p_fct_cache = opts->p_fct_cache
     };
     SEXP col = vec_cast_opts(&col_opts);
 
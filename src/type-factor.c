@@ -1,6 +1,8 @@
 #include <rlang.h>
 #include "vctrs.h"
 #include "ptype2.h"
+#include "translate.h"
+#include "type-factor.h"
 #include "utils.h"
 
 static SEXP levels_union(SEXP x, SEXP y);
@@ -89,6 +91,165 @@ static SEXP levels_union(SEXP x, SEXP y) {
   return out;
 }
 
+/*
+ * A levels union accumulates the levels of a sequence of factors, in
+ * order of appearance, with a single dictionary that grows across the
+ * whole sequence. This is how `vec_ptype_common()` folds consecutive
+ * factors instead of merging their levels pairwise with `levels_union()`.
+ *
+ * The union is a list of:
+ * - The levels, with spare capacity at the end.
+ * - An open addressing hash table of 0-based locations in the levels,
+ *   with twice the capacity of the levels. Empty slots are `-1`.
+ * - The number of levels, as an integer scalar.
+ *
+ * Levels are only ever appended, so the location of a level doesn't
+ * change as the union grows. `fct_levels_union_finalise()` returns the
+ * levels without their spare capacity.
+ */
+
+enum levels_union_elt {
+  LEVELS_UNION_levels,
+  LEVELS_UNION_slots,
+  LEVELS_UNION_size
+};
+
+#define LEVELS_UNION_MIN_CAPACITY 16
+
+// Fibonacci hashing of the address of the normalised `CHARSXP`
+static inline uint32_t levels_hash(SEXP x) {
+  return (uint32_t) (((uint64_t) (uintptr_t) x * UINT64_C(0x9e3779b97f4a7c15)) >> 32);
+}
+
+// Returns the location of `elt` in `p_levels`, or `-1` if it is missing,
+// in which case `*p_slot` is the empty slot where it would be inserted
+static inline int levels_union_find(const SEXP* p_levels,
+                                    const int* p_slots,
+                                    uint32_t mask,
+                                    SEXP elt,
+                                    uint32_t* p_slot) {
+  uint32_t i = levels_hash(elt) & mask;
+
+  while (true) {
+    const int loc = p_slots[i];
+
+    if (loc < 0 || p_levels[loc] == elt) {
+      *p_slot = i;
+      return loc;
+    }
+
+    i = (i + 1) & mask;
+  }
+}
+
+static void levels_union_reserve(SEXP u, R_len_t capacity) {
+  SEXP old_levels = VECTOR_ELT(u, LEVELS_UNION_levels);
+  if (old_levels != R_NilValue && Rf_length(old_levels) >= capacity) {
+    return;
+  }
+
+  R_len_t size = INTEGER(VECTOR_ELT(u, LEVELS_UNION_size))[0];
+
+  R_len_t new_capacity = LEVELS_UNION_MIN_CAPACITY;
+  while (new_capacity < capacity) {
+    new_capacity *= 2;
+  }
+
+  SEXP levels = PROTECT(Rf_allocVector(STRSXP, new_capacity));
+  for (R_len_t i = 0; i < size; ++i) {
+    SET_STRING_ELT(levels, i, STRING_ELT(old_levels, i));
+  }
+
+  SEXP slots = PROTECT(Rf_allocVector(INTSXP, (r_ssize) new_capacity * 2));
+  int* p_slots = INTEGER(slots);
+  r_p_int_fill(p_slots, -1, new_capacity * 2);
+
+  const SEXP* p_levels = STRING_PTR_RO(levels);
+  const uint32_t mask = new_capacity * 2 - 1;
+
+  for (R_len_t i = 0; i < size; ++i) {
+    uint32_t slot;
+    levels_union_find(p_levels, p_slots, mask, p_levels[i], &slot);
+    p_slots[slot] = i;
+  }
+
+  SET_VECTOR_ELT(u, LEVELS_UNION_levels, levels);
+  SET_VECTOR_ELT(u, LEVELS_UNION_slots, slots);
+
+  UNPROTECT(2);
+}
+
+// [[ include("type-factor.h") ]]
+SEXP fct_levels_union_new(SEXP levels) {
+  SEXP u = PROTECT(Rf_allocVector(VECSXP, 3));
+  SET_VECTOR_ELT(u, LEVELS_UNION_size, r_int(0));
+
+  levels_union_reserve(u, Rf_length(levels));
+  fct_levels_union_push(u, levels);
+
+  UNPROTECT(1);
+  return u;
+}
+
+// [[ include("type-factor.h") ]]
+void fct_levels_union_push(SEXP u, SEXP levels) {
+  R_len_t n = Rf_length(levels);
+  const SEXP* p_new = STRING_PTR_RO(levels);
+
+  int* p_size = INTEGER(VECTOR_ELT(u, LEVELS_UNION_size));
+
+  SEXP out = VECTOR_ELT(u, LEVELS_UNION_levels);
+  const SEXP* p_out = STRING_PTR_RO(out);
+  int* p_slots = INTEGER(VECTOR_ELT(u, LEVELS_UNION_slots));
+  uint32_t mask = Rf_length(out) * 2 - 1;
+
+  for (R_len_t i = 0; i < n; ++i) {
+    SEXP elt = p_new[i];
+
+    if (!string_is_normalized(elt)) {
+      elt = string_normalize(elt);
+    }
+
+    uint32_t slot;
+    if (levels_union_find(p_out, p_slots, mask, elt, &slot) >= 0) {
+      continue;
+    }
+
+    if (*p_size == Rf_length(out)) {
+      PROTECT(elt);
+      levels_union_reserve(u, *p_size + 1);
+      UNPROTECT(1);
+
+      out = VECTOR_ELT(u, LEVELS_UNION_levels);
+      p_out = STRING_PTR_RO(out);
+      p_slots = INTEGER(VECTOR_ELT(u, LEVELS_UNION_slots));
+      mask = Rf_length(out) * 2 - 1;
+
+      levels_union_find(p_out, p_slots, mask, elt, &slot);
+    }
+
+    SET_STRING_ELT(out, *p_size, elt);
+    p_slots[slot] = *p_size;
+    ++(*p_size);
+  }
+}
+
+// [[ include("type-factor.h") ]]
+SEXP fct_levels_union_finalise(SEXP u) {
+  R_len_t size = INTEGER(VECTOR_ELT(u, LEVELS_UNION_size))[0];
+  SEXP levels = VECTOR_ELT(u, LEVELS_UNION_levels);
+
+  SEXP out = PROTECT(Rf_allocVector(STRSXP, size));
+  for (R_len_t i = 0; i < size; ++i) {
+    SET_STRING_ELT(out, i, STRING_ELT(levels, i));
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+#undef LEVELS_UNION_MIN_CAPACITY
+
 // -----------------------------------------------------------------------------
 
 static void init_factor(SEXP x, SEXP levels);
@@ -229,14 +390,20 @@ static SEXP remove_na_levels(SEXP levels) {
 }
 
 
-static SEXP fct_as_factor_impl(SEXP x, SEXP x_levels, SEXP to_levels, bool* lossy, bool ordered);
+static SEXP fct_as_factor_impl(SEXP x,
+                               SEXP x_levels,
+                               SEXP to_levels,
+                               bool* lossy,
+                               bool ordered,
+                               struct fct_recode_cache* p_cache);
 
-// [[ include("vctrs.h") ]]
+// [[ include("type-factor.h") ]]
 SEXP fct_as_factor(SEXP x,
                    SEXP to,
                    bool* lossy,
                    struct vctrs_arg* x_arg,
-                   struct vctrs_arg* to_arg) {
+                   struct vctrs_arg* to_arg,
+                   struct fct_recode_cache* p_cache) {
 
   SEXP x_levels = PROTECT(Rf_getAttrib(x, R_LevelsSymbol));
   SEXP to_levels = PROTECT(Rf_getAttrib(to, R_LevelsSymbol));
@@ -249,7 +416,7 @@ SEXP fct_as_factor(SEXP x,
     stop_corrupt_factor_levels(to, to_arg);
   }
 
-  SEXP out = fct_as_factor_impl(x, x_levels, to_levels, lossy, false);
+  SEXP out = fct_as_factor_impl(x, x_levels, to_levels, lossy, false, p_cache);
 
   UNPROTECT(2);
   return out;
@@ -261,7 +428,22 @@ SEXP ord_as_ordered(const struct cast_opts* opts) {
   return opts->x;
 }
 
-static SEXP fct_as_factor_impl(SEXP x, SEXP x_levels, SEXP to_levels, bool* lossy, bool ordered) {
+static SEXP fct_recode_cache_get(struct fct_recode_cache* p_cache,
+                                 SEXP x_levels,
+                                 SEXP to_levels,
+                                 bool* hit);
+static void fct_recode_cache_set(struct fct_recode_cache* p_cache,
+                                 SEXP x_levels,
+                                 SEXP to_levels,
+                                 SEXP recode);
+static SEXP fct_recode(SEXP x_levels, SEXP to_levels, bool* lossy);
+
+static SEXP fct_as_factor_impl(SEXP x,
+                               SEXP x_levels,
+                               SEXP to_levels,
+                               bool* lossy,
+                               bool ordered,
+                               struct fct_recode_cache* p_cache) {
   // Early exit if levels are identical
   if (x_levels == to_levels) {
     return x;
@@ -282,24 +464,25 @@ static SEXP fct_as_factor_impl(SEXP x, SEXP x_levels, SEXP to_levels, bool* loss
     return R_NilValue;
   }
 
-  R_len_t x_size = vec_size(x);
-
-  const SEXP* p_x_levels = STRING_PTR_RO(x_levels);
-  const SEXP* p_to_levels = STRING_PTR_RO(to_levels);
+  // Chunks of the same factor are often cast to the same levels one
+  // after the other, as in `vec_c()` and `vec_rbind()`
+  bool hit = false;
+  SEXP recode = fct_recode_cache_get(p_cache, x_levels, to_levels, &hit);
 
-  bool is_contiguous_subset = true;
-
-  for (R_len_t i = 0; i < x_levels_size; ++i) {
-    if (p_x_levels[i] != p_to_levels[i]) {
-      is_contiguous_subset = false;
-      break;
+  if (!hit) {
+    recode = fct_recode(x_levels, to_levels, lossy);
+    if (*lossy) {
+      return R_NilValue;
     }
+    PROTECT(recode);
+    fct_recode_cache_set(p_cache, x_levels, to_levels, recode);
+    UNPROTECT(1);
   }
 
   // No recoding required if contiguous subset.
   // Duplicate, strip non-factor attributes, and re-initialize with new levels.
   // Using `r_clone_referenced()` avoids an immediate copy using ALTREP wrappers.
-  if (is_contiguous_subset) {
+  if (recode == R_NilValue) {
     SEXP out = PROTECT(r_clone_referenced(x));
     SET_ATTRIB(out, R_NilValue);
 
@@ -313,6 +496,10 @@ static SEXP fct_as_factor_impl(SEXP x, SEXP x_levels, SEXP to_levels, bool* loss
     return out;
   }
 
+  PROTECT(recode);
+  const int* p_recode = INTEGER_RO(recode);
+
+  R_len_t x_size = vec_size(x);
   const int* p_x = INTEGER_RO(x);
 
   SEXP out = PROTECT(Rf_allocVector(INTSXP, x_size));
@@ -324,34 +511,127 @@ static SEXP fct_as_factor_impl(SEXP x, SEXP x_levels, SEXP to_levels, bool* loss
     init_factor(out, to_levels);
   }
 
+  // Recode `x` int values into `to` level ordering
+  for (R_len_t i = 0; i < x_size; ++i) {
+    const int elt = p_x[i];
+
+    if (elt == NA_INTEGER) {
+      p_out[i] = NA_INTEGER;
+      continue;
+    }
+
+    p_out[i] = p_recode[elt - 1];
+  }
+
+  UNPROTECT(2);
+  return out;
+}
+
+// Returns the locations of `x_levels` in `to_levels`, or `NULL` if
+// `x_levels` are the first levels of `to_levels`, in which case the
+// codes of `x` don't need to be recoded
+static SEXP fct_recode(SEXP x_levels, SEXP to_levels, bool* lossy) {
+  R_len_t x_levels_size = vec_size(x_levels);
+
+  const SEXP* p_x_levels = STRING_PTR_RO(x_levels);
+  const SEXP* p_to_levels = STRING_PTR_RO(to_levels);
+
+  bool is_contiguous_subset = true;
+
+  for (R_len_t i = 0; i < x_levels_size; ++i) {
+    if (p_x_levels[i] != p_to_levels[i]) {
+      is_contiguous_subset = false;
+      break;
+    }
+  }
+
+  if (is_contiguous_subset) {
+    return R_NilValue;
+  }
+
   SEXP recode = PROTECT(vec_match(x_levels, to_levels));
+
   const int* p_recode = INTEGER_RO(recode);
 
   // Detect if there are any levels in `x` that aren't in `to`
   for (R_len_t i = 0; i < x_levels_size; ++i) {
     if (p_recode[i] == NA_INTEGER) {
       *lossy = true;
-      UNPROTECT(2);
+      UNPROTECT(1);
       return R_NilValue;
     }
   }
 
-  // Recode `x` int values into `to` level ordering
-  for (R_len_t i = 0; i < x_size; ++i) {
-    const int elt = p_x[i];
+  UNPROTECT(1);
+  return recode;
+}
 
-    if (elt == NA_INTEGER) {
-      p_out[i] = NA_INTEGER;
-      continue;
+#define FCT_RECODE_CACHE_SIZE 16
+
+enum fct_recode_cache_elt {
+  FCT_RECODE_CACHE_x_levels,
+  FCT_RECODE_CACHE_to_levels,
+  FCT_RECODE_CACHE_recode,
+  FCT_RECODE_CACHE_N_ELTS
+};
+
+// [[ include("type-factor.h") ]]
+struct fct_recode_cache new_fct_recode_cache() {
+  return (struct fct_recode_cache) {
+    .shelter = R_NilValue,
+    .n = 0
+  };
+}
+
+static SEXP fct_recode_cache_get(struct fct_recode_cache* p_cache,
+                                 SEXP x_levels,
+                                 SEXP to_levels,
+                                 bool* hit) {
+  *hit = false;
+
+  if (p_cache == NULL || p_cache->n == 0) {
+    return R_NilValue;
+  }
+
+  R_len_t n = p_cache->n < FCT_RECODE_CACHE_SIZE ? p_cache->n : FCT_RECODE_CACHE_SIZE;
+  const SEXP* p_shelter = VECTOR_PTR_RO(p_cache->shelter);
+
+  for (R_len_t i = 0; i < n; ++i) {
+    const SEXP* p_entry = p_shelter + i * FCT_RECODE_CACHE_N_ELTS;
+
+    if (p_entry[FCT_RECODE_CACHE_x_levels] == x_levels &&
+        p_entry[FCT_RECODE_CACHE_to_levels] == to_levels) {
+      *hit = true;
+      return p_entry[FCT_RECODE_CACHE_recode];
     }
+  }
 
-    p_out[i] = p_recode[elt - 1];
+  return R_NilValue;
+}
+
+static void fct_recode_cache_set(struct fct_recode_cache* p_cache,
+                                 SEXP x_levels,
+                                 SEXP to_levels,
+                                 SEXP recode) {
+  if (p_cache == NULL) {
+    return;
   }
 
-  UNPROTECT(2);
-  return out;
+  if (p_cache->shelter == R_NilValue) {
+    p_cache->shelter = Rf_allocVector(VECSXP, FCT_RECODE_CACHE_SIZE * FCT_RECODE_CACHE_N_ELTS);
+    REPROTECT(p_cache->shelter, p_cache->shelter_pi);
+  }
+
+  R_len_t loc = (p_cache->n % FCT_RECODE_CACHE_SIZE) * FCT_RECODE_CACHE_N_ELTS;
+
+  SET_VECTOR_ELT(p_cache->shelter, loc + FCT_RECODE_CACHE_x_levels, x_levels);
+  SET_VECTOR_ELT(p_cache->shelter, loc + FCT_RECODE_CACHE_to_levels, to_levels);
+  SET_VECTOR_ELT(p_cache->shelter, loc + FCT_RECODE_CACHE_recode, recode);
+
+  ++p_cache->n;
 }
 
+#undef FCT_RECODE_CACHE_SIZE
 
 static void init_factor(SEXP x, SEXP levels) {
   if (TYPEOF(x) != INTSXP) {
@@ -9,4 +9,38 @@ SEXP fct_ptype2(const struct ptype2_opts* opts);
 SEXP ord_ptype2(const struct ptype2_opts* opts);
 SEXP ord_as_ordered(const struct cast_opts* opts);
 
+SEXP fct_levels_union_new(SEXP levels);
+void fct_levels_union_push(SEXP u, SEXP levels);
+SEXP fct_levels_union_finalise(SEXP u);
+
+/*
+ * A recode cache holds the level recodings computed by the casts of one
+ * operation, such as `vec_c()` or `vec_cast_common()`, so that casts
+ * between the same pair of levels objects reuse them.
+ *
+ * @member shelter A list of `x_levels`, `to_levels`, and recoding
+ *   triples. It keeps the levels alive so that their addresses identify
+ *   them. It is `NULL` until the first recoding is stored, so operations
+ *   that don't cast factors don't allocate it. Must be protected with
+ *   `PROTECT_WITH_INDEX()` by the caller until the operation returns.
+ * @member shelter_pi A protection index to `shelter` so it can reprotect
+ *   itself upon allocation.
+ * @member n The number of recodings added to the cache so far. Once the
+ *   cache is full, the oldest entries are replaced first.
+ */
+struct fct_recode_cache {
+  SEXP shelter;
+  PROTECT_INDEX shelter_pi;
+  R_len_t n;
+};
+
+struct fct_recode_cache new_fct_recode_cache();
+
+SEXP fct_as_factor(SEXP x,
+                   SEXP to,
+                   bool* lossy,
+                   struct vctrs_arg* x_arg,
+                   struct vctrs_arg* to_arg,
+                   struct fct_recode_cache* p_cache);
+
 #endif
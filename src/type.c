@@ -4,6 +4,7 @@
 #include "ptype-common.h"
 #include "ptype2.h"
 #include "type-data-frame.h"
+#include "type-factor.h"
 #include "utils.h"
 #include "decl/ptype-decl.h"
 
@@ -205,7 +206,17 @@ static SEXP vec_ptype_finalise_dispatch(SEXP x) {
   );
 }
 
+struct ptype_common_data {
+  struct fallback_opts fallback;
+  // Last input that was folded into the common type with `vec_ptype2()`
+  SEXP prev;
+  // Holds the union of the levels of consecutive factors while they are
+  // being folded, or `NULL`
+  SEXP shelter;
+};
+
 static SEXP vctrs_type2_common(SEXP current, SEXP next, struct counters* counters, void* data);
+static SEXP ptype_common_levels_union_finalise(struct ptype_common_data* p_data);
 
 // [[ register(external = TRUE) ]]
 SEXP vctrs_type_common(SEXP call, SEXP op, SEXP args, SEXP env) {
@@ -260,22 +271,87 @@ SEXP vec_ptype_common_opts(SEXP dots,
     Rf_errorcall(R_NilValue, "strict mode is activated; you must supply complete `.ptype`.");
   }
 
-  // Remove constness
-  struct fallback_opts mut_opts = *opts;
+  struct ptype_common_data data = {
+    .fallback = *opts,
+    .prev = NULL,
+    .shelter = PROTECT(Rf_allocVector(VECSXP, 1))
+  };
 
   // Start reduction with the `.ptype` argument
-  SEXP type = PROTECT(reduce(ptype, args_dot_ptype, dots, &vctrs_type2_common, &mut_opts));
+  SEXP type = reduce(ptype, args_dot_ptype, dots, &vctrs_type2_common, &data);
+  PROTECT_INDEX type_pi;
+  PROTECT_WITH_INDEX(type, &type_pi);
+
+  if (VECTOR_ELT(data.shelter, 0) != R_NilValue) {
+    type = ptype_common_levels_union_finalise(&data);
+    REPROTECT(type, type_pi);
+  }
+
   type = vec_ptype_finalise(type);
 
-  UNPROTECT(1);
+  UNPROTECT(2);
   return type;
 }
 
+static inline
+bool is_levels_union_candidate(SEXP x) {
+  return
+    class_type(x) == vctrs_class_bare_factor &&
+    TYPEOF(Rf_getAttrib(x, R_LevelsSymbol)) == STRSXP;
+}
+
+static
+SEXP ptype_common_levels_union_finalise(struct ptype_common_data* p_data) {
+  SEXP levels = PROTECT(fct_levels_union_finalise(VECTOR_ELT(p_data->shelter, 0)));
+  SET_VECTOR_ELT(p_data->shelter, 0, R_NilValue);
+
+  SEXP out = new_empty_factor(levels);
+
+  UNPROTECT(1);
+  return out;
+}
+
 
 static SEXP vctrs_type2_common(SEXP current,
                                SEXP next,
                                struct counters* counters,
                                void* data) {
+  struct ptype_common_data* p_data = (struct ptype_common_data*) data;
+
+  // The common type already includes the type of the previous input. When
+  // `next` has the same type, it can't change the common type and
+  // `vec_ptype2()` doesn't need to be called.
+  if (p_data->prev != NULL && ptype_fingerprint_equal(p_data->prev, next)) {
+    return current;
+  }
+
+  // Consecutive factors are folded into a single growing union of their
+  // levels rather than merged pairwise by `vec_ptype2()`. While a union
+  // is in progress, `current` is stale and gets updated only once an
+  // input of another type comes in, or at the end of the reduction.
+  bool has_union = VECTOR_ELT(p_data->shelter, 0) != R_NilValue;
+
+  if (is_levels_union_candidate(next)) {
+    if (has_union) {
+      fct_levels_union_push(VECTOR_ELT(p_data->shelter, 0), Rf_getAttrib(next, R_LevelsSymbol));
+      p_data->prev = next;
+      return current;
+    }
+    if (is_levels_union_candidate(current)) {
+      SEXP u = fct_levels_union_new(Rf_getAttrib(current, R_LevelsSymbol));
+      SET_VECTOR_ELT(p_data->shelter, 0, u);
+      fct_levels_union_push(u, Rf_getAttrib(next, R_LevelsSymbol));
+      p_data->prev = next;
+      return current;
+    }
+  } else if (has_union) {
+    if (next == R_NilValue) {
+      return current;
+    }
+    current = ptype_common_levels_union_finalise(p_data);
+  }
+  PROTECT(current);
+
   int left = -1;
 
   const struct ptype2_opts opts = {
@@ -283,10 +359,11 @@ static SEXP vctrs_type2_common(SEXP current,
     .y = next,
     .x_arg = counters->curr_arg,
     .y_arg = counters->next_arg,
-    .fallback = *((struct fallback_opts*) data)
+    .fallback = p_data->fallback
   };
 
   current = vec_ptype2_opts(&opts, &left);
+  p_data->prev = next;
 
   // Update current if RHS is the common type. Otherwise the previous
   // counter stays in effect.
@@ -294,10 +371,105 @@ static SEXP vctrs_type2_common(SEXP current,
     counters_shift(counters);
   }
 
+  UNPROTECT(1);
   return current;
 }
 
 
+/*
+ * Do `x` and `y` have the same prototype? This is a cheap and conservative
+ * check for the types whose prototype is entirely determined by their type
+ * and attributes, such as bare vectors, factors, dates, and bare data frames
+ * of those. It returns `false` for anything else, including S3 classes whose
+ * prototype might depend on their data, like records.
+ */
+static
+bool ptype_fingerprint_equal(SEXP x, SEXP y) {
+  if (x == y) {
+    return true;
+  }
+  if (TYPEOF(x) != TYPEOF(y)) {
+    return false;
+  }
+
+  const enum vctrs_class_type x_class = class_type(x);
+
+  if (x_class != class_type(y)) {
+    return false;
+  }
+
+  switch (x_class) {
+  case vctrs_class_none:
+    return bare_fingerprint_equal(x, y);
+
+  case vctrs_class_bare_factor:
+  case vctrs_class_bare_ordered:
+    return equal_object(
+      Rf_getAttrib(x, R_LevelsSymbol),
+      Rf_getAttrib(y, R_LevelsSymbol)
+    );
+
+  case vctrs_class_bare_date:
+    return true;
+
+  case vctrs_class_bare_posixct:
+    return equal_object(
+      Rf_getAttrib(x, syms_tzone),
+      Rf_getAttrib(y, syms_tzone)
+    );
+
+  case vctrs_class_bare_data_frame:
+  case vctrs_class_bare_tibble: {
+    if (!equal_object(r_names(x), r_names(y))) {
+      return false;
+    }
+
+    R_len_t n_cols = Rf_length(x);
+
+    for (R_len_t i = 0; i < n_cols; ++i) {
+      if (!ptype_fingerprint_equal(VECTOR_ELT(x, i), VECTOR_ELT(y, i))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  default:
+    return false;
+  }
+}
+
+// Bare vectors may only have names, which are not part of their prototype
+static
+bool bare_fingerprint_equal(SEXP x, SEXP y) {
+  if (!attrib_only_names(ATTRIB(x)) || !attrib_only_names(ATTRIB(y))) {
+    return false;
+  }
+
+  switch (TYPEOF(x)) {
+  case LGLSXP: return vec_is_unspecified(x) == vec_is_unspecified(y);
+  case INTSXP:
+  case REALSXP:
+  case CPLXSXP:
+  case STRSXP:
+  case RAWSXP:
+  case VECSXP: return true;
+  default: return false;
+  }
+}
+
+static inline
+bool attrib_only_names(SEXP attrib) {
+  for (SEXP node = attrib; node != R_NilValue; node = CDR(node)) {
+    if (TAG(node) != R_NamesSymbol) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
 void vctrs_init_type(SEXP ns) {
   syms_vec_ptype = Rf_install("vec_ptype");
 
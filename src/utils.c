@@ -910,8 +910,60 @@ SEXP compact_rep_materialize(SEXP x) {
   return out;
 }
 
+// Initialised at load time
+SEXP compact_runs_attrib = NULL;
+
+// Returns compact runs that `vec_slice()` and `vec_assign()` understand.
+// The first element is the total size and is followed by `n_runs` pairs
+// of a 0-based `start` and a `size`, to be filled by the caller with
+// `init_compact_runs()`. Runs never contain missing locations.
+SEXP compact_runs(R_len_t n_runs) {
+  if (n_runs < 0) {
+    r_stop_internal("compact_runs", "Negative `n_runs` in `compact_runs()`.");
+  }
+
+  SEXP runs = PROTECT(Rf_allocVector(INTSXP, 1 + 2 * n_runs));
+  INTEGER(runs)[0] = 0;
+
+  SET_ATTRIB(runs, compact_runs_attrib);
+
+  UNPROTECT(1);
+  return runs;
+}
+
+void init_compact_runs(int* p, R_len_t i, R_len_t start, R_len_t size) {
+  p[1 + 2 * i] = start;
+  p[2 + 2 * i] = size;
+  p[0] += size;
+}
+
+bool is_compact_runs(SEXP x) {
+  return ATTRIB(x) == compact_runs_attrib;
+}
+
+// Materialize 1-based locations
+SEXP compact_runs_materialize(SEXP x) {
+  const int* p = INTEGER_RO(x);
+  R_len_t n_runs = compact_runs_n(x);
+
+  SEXP out = PROTECT(Rf_allocVector(INTSXP, p[0]));
+  int* out_data = INTEGER(out);
+
+  for (R_len_t i = 0; i < n_runs; ++i) {
+    R_len_t start = p[1 + 2 * i] + 1;
+    R_len_t size = p[2 + 2 * i];
+
+    for (R_len_t j = 0; j < size; ++j, ++out_data) {
+      *out_data = start + j;
+    }
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
 bool is_compact(SEXP x) {
-  return is_compact_rep(x) || is_compact_seq(x);
+  return is_compact_rep(x) || is_compact_seq(x) || is_compact_runs(x);
 }
 
 SEXP compact_materialize(SEXP x) {
@@ -919,6 +971,8 @@ SEXP compact_materialize(SEXP x) {
     return compact_rep_materialize(x);
   } else if (is_compact_seq(x)) {
     return compact_seq_materialize(x);
+  } else if (is_compact_runs(x)) {
+    return compact_runs_materialize(x);
   } else {
     return x;
   }
@@ -929,6 +983,8 @@ R_len_t vec_subscript_size(SEXP x) {
     return r_int_get(x, 1);
   } else if (is_compact_seq(x)) {
     return r_int_get(x, 1);
+  } else if (is_compact_runs(x)) {
+    return r_int_get(x, 0);
   } else {
     return vec_size(x);
   }
@@ -1538,6 +1594,8 @@ SEXP chrs_cast = NULL;
 SEXP chrs_error = NULL;
 SEXP chrs_combine = NULL;
 SEXP chrs_convert = NULL;
+SEXP chrs_asc = NULL;
+SEXP chrs_largest = NULL;
 
 SEXP syms_i = NULL;
 SEXP syms_n = NULL;
@@ -1755,6 +1813,8 @@ void vctrs_init_utils(SEXP ns) {
   chrs_error = r_new_shared_character("error");
   chrs_combine = r_new_shared_character("combine");
   chrs_convert = r_new_shared_character("convert");
+  chrs_asc = r_new_shared_character("asc");
+  chrs_largest = r_new_shared_character("largest");
 
   classes_tibble = r_new_shared_vector(STRSXP, 3);
 
@@ -1888,6 +1948,10 @@ void vctrs_init_utils(SEXP ns) {
   R_PreserveObject(compact_rep_attrib);
   SET_TAG(compact_rep_attrib, Rf_install("vctrs_compact_rep"));
 
+  compact_runs_attrib = Rf_cons(R_NilValue, R_NilValue);
+  R_PreserveObject(compact_runs_attrib);
+  SET_TAG(compact_runs_attrib, Rf_install("vctrs_compact_runs"));
+
   {
     SEXP result_names = PROTECT(Rf_allocVector(STRSXP, 2));
     SET_STRING_ELT(result_names, 0, Rf_mkChar("ok"));
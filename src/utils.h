@@ -184,6 +184,14 @@ void init_compact_rep(int* p, R_len_t i, R_len_t n);
 SEXP compact_rep(R_len_t i, R_len_t n);
 bool is_compact_rep(SEXP x);
 
+SEXP compact_runs(R_len_t n_runs);
+void init_compact_runs(int* p, R_len_t i, R_len_t start, R_len_t size);
+bool is_compact_runs(SEXP x);
+
+static inline R_len_t compact_runs_n(SEXP x) {
+  return (Rf_length(x) - 1) / 2;
+}
+
 bool is_compact(SEXP x);
 SEXP compact_materialize(SEXP x);
 R_len_t vec_subscript_size(SEXP x);
@@ -455,6 +463,8 @@ extern SEXP chrs_cast;
 extern SEXP chrs_error;
 extern SEXP chrs_combine;
 extern SEXP chrs_convert;
+extern SEXP chrs_asc;
+extern SEXP chrs_largest;
 
 extern SEXP syms_i;
 extern SEXP syms_n;